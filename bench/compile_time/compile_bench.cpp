@@ -0,0 +1,466 @@
+// Compile-time scaling benchmark.
+//
+// Generates graphs of several shapes and sizes, compiles each one with every given compiler and
+// records the wall-clock compile time, the peak RSS of the compiler and the object size as JSON:
+//
+//   ugraph_compile_bench --include <ugraph/include> --work <dir> --out compile_time.json
+//                        --compiler g++ --compiler clang++ [--sizes 10,100,500] [--shapes chain,nested]
+//                        [--flags "-std=c++17 -O2"] [--timeout 600]
+//
+// Shapes: chain, fan_in (binary reduction tree), diamond (chained diamonds), layered (random DAG
+// with a fixed seed), nested (chain of nested 10 node graphs), deep (binary tree of nested two node
+// graphs, log2(n) levels) and topology (the layered edges declared as a bare Topology). Once a shape times out or fails for a compiler, its larger sizes
+// are recorded as skipped.
+//
+// POSIX only: the compiler runs in a child process, the peak RSS is the one reported by wait4.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <csignal>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    struct Node {
+        std::size_t id;
+        std::size_t in = 0;
+        std::size_t out = 0;
+    };
+
+    struct Edge {
+        std::size_t src;        // node index
+        std::size_t src_port;
+        std::size_t dst;        // node index
+        std::size_t dst_port;
+    };
+
+    struct Shape {
+        std::vector<Node> nodes;
+        std::vector<Edge> edges;
+    };
+
+    void connect(Shape& s, std::size_t src, std::size_t dst) {
+        s.edges.push_back({ src, 0, dst, s.nodes[dst].in++ });
+        s.nodes[src].out = 1;
+    }
+
+    Shape make_nodes(std::size_t count) {
+        Shape s;
+        for (std::size_t i = 0; i < count; ++i) {
+            s.nodes.push_back({ i + 1 });
+        }
+        return s;
+    }
+
+    Shape make_chain(std::size_t n) {
+        Shape s = make_nodes(std::max<std::size_t>(n, 2));
+        for (std::size_t i = 0; i + 1 < s.nodes.size(); ++i) {
+            connect(s, i, i + 1);
+        }
+        return s;
+    }
+
+    Shape make_fan_in(std::size_t n) {
+        Shape s = make_nodes(std::max<std::size_t>(n, 2));
+        for (std::size_t i = 1; i < s.nodes.size(); ++i) {
+            connect(s, i, (i - 1) / 2);
+        }
+        return s;
+    }
+
+    Shape make_diamond(std::size_t n) {
+        const std::size_t blocks = std::max<std::size_t>(n / 4, 1);
+        Shape s = make_nodes(blocks * 4);
+        for (std::size_t b = 0; b < blocks; ++b) {
+            const std::size_t t = b * 4;
+            connect(s, t, t + 1);
+            connect(s, t, t + 2);
+            connect(s, t + 1, t + 3);
+            connect(s, t + 2, t + 3);
+            if (b + 1 < blocks) {
+                connect(s, t + 3, t + 4);
+            }
+        }
+        return s;
+    }
+
+    Shape make_layered(std::size_t n) {
+        std::size_t width = 2;
+        while (width * width < n) ++width;
+        const std::size_t layers = std::max<std::size_t>(n / width, 2);
+        Shape s = make_nodes(layers * width);
+        std::mt19937 rng(1234);
+        for (std::size_t l = 1; l < layers; ++l) {
+            for (std::size_t w = 0; w < width; ++w) {
+                const std::size_t dst = l * width + w;
+                const std::size_t first = rng() % width;
+                connect(s, (l - 1) * width + first, dst);
+                if (rng() % 2) {
+                    connect(s, (l - 1) * width + (first + 1 + rng() % (width - 1)) % width, dst);
+                }
+            }
+        }
+        return s;
+    }
+
+    std::string module_name(const Node& n) {
+        return "Mod<" + std::to_string(n.in) + ", " + std::to_string(n.out) + ">";
+    }
+
+    std::string edge_expr(const Edge& e) {
+        std::ostringstream os;
+        os << "n" << e.src << ".output<int, " << e.src_port << ">() >> n" << e.dst << ".input<int, " << e.dst_port << ">()";
+        return os.str();
+    }
+
+    constexpr const char* prelude = R"(#include "ugraph.hpp"
+
+template<std::size_t in, std::size_t out>
+struct Mod {
+    using Manifest = ugraph::Manifest< ugraph::IO<int, in, out, false> >;
+    int state = 0;
+    template<typename context_t>
+    void process(context_t& ctx) {
+        int v = state;
+        if constexpr (in > 0) for (const auto& x : ctx.template inputs<int>()) v += x;
+        if constexpr (out > 0) for (auto& y : ctx.template outputs<int>()) y = v;
+    }
+};
+
+)";
+
+    constexpr const char* run_graph = R"(
+void run() {
+    static auto g = make();
+    static decltype(g)::graph_data_t data;
+    g.init_graph_data(data);
+    g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+}
+)";
+
+    std::string graph_source(const Shape& s) {
+        std::ostringstream os;
+        os << prelude;
+        for (std::size_t i = 0; i < s.nodes.size(); ++i) {
+            os << module_name(s.nodes[i]) << " m" << i << ";\n";
+        }
+        os << "\nauto make() {\n";
+        for (std::size_t i = 0; i < s.nodes.size(); ++i) {
+            os << "    auto n" << i << " = ugraph::make_node<" << s.nodes[i].id << ">(m" << i << ");\n";
+        }
+        os << "    return ugraph::Graph(\n";
+        for (std::size_t i = 0; i < s.edges.size(); ++i) {
+            os << "        " << edge_expr(s.edges[i]) << (i + 1 < s.edges.size() ? ",\n" : "\n");
+        }
+        os << "    );\n}\n" << run_graph;
+        return os.str();
+    }
+
+    // Chain of nested graphs, each a 10 node chain; inner ids 1..10, wrapper ids 100 * (k + 1)
+    std::string nested_source(std::size_t n, std::size_t& node_count, std::size_t& edge_count) {
+        constexpr std::size_t inner = 10;
+        const std::size_t groups = std::max<std::size_t>(n / inner, 2);
+        node_count = groups * inner;
+        edge_count = groups * (inner - 1) + groups - 1;
+
+        std::ostringstream os;
+        os << prelude;
+        os << "struct Inner {\n    Mod<1, 1> m[" << inner << "];\n};\n\n";
+        os << "auto make_inner(Inner& in) {\n";
+        for (std::size_t i = 0; i < inner; ++i) {
+            os << "    auto n" << i << " = ugraph::make_node<" << i + 1 << ">(in.m[" << i << "]);\n";
+        }
+        os << "    return ugraph::Graph(\n";
+        for (std::size_t i = 0; i + 1 < inner; ++i) {
+            os << "        n" << i << ".output<int>() >> n" << i + 1 << ".input<int>()" << (i + 2 < inner ? ",\n" : "\n");
+        }
+        os << "    );\n}\n\n";
+        os << "using inner_t = decltype(make_inner(std::declval<Inner&>()));\n";
+        os << "Inner inners[" << groups << "];\n\n";
+        os << "auto make() {\n";
+        os << "    static inner_t graphs[] = {\n";
+        for (std::size_t k = 0; k < groups; ++k) {
+            os << "        make_inner(inners[" << k << "])" << (k + 1 < groups ? ",\n" : "\n");
+        }
+        os << "    };\n";
+        for (std::size_t k = 0; k < groups; ++k) {
+            os << "    auto g" << k << " = ugraph::make_node<" << 100 * (k + 1) << ">(graphs[" << k << "]);\n";
+        }
+        os << "    return ugraph::Graph(\n";
+        for (std::size_t k = 0; k + 1 < groups; ++k) {
+            os << "        g" << k << ".output<int>() >> g" << k + 1 << ".input<int>()" << (k + 2 < groups ? ",\n" : "\n");
+        }
+        os << "    );\n}\n" << run_graph;
+        return os.str();
+    }
+
+    // Binary tree of nested graphs: every level is a graph of two nodes wrapping the level below,
+    // level 0 being Mod<1, 1> leaves. n rounds up to a power of two, at least two levels deep.
+    std::string deep_source(std::size_t n, std::size_t& node_count, std::size_t& edge_count) {
+        std::size_t depth = 2;
+        while ((std::size_t(1) << depth) < n) ++depth;
+        node_count = std::size_t(1) << depth;
+        edge_count = node_count - 1;
+
+        std::ostringstream os;
+        os << prelude;
+        os << "Mod<1, 1> l0[" << node_count << "];\n\n";
+        std::size_t id_base = 1;
+        for (std::size_t l = 1; l <= depth; ++l) {
+            const std::string child = l == 1 ? "l0[" : "*g" + std::to_string(l - 1) + "[";
+            os << "auto make_l" << l << "(std::size_t i) {\n"
+                << "    auto a = ugraph::make_node<" << id_base << ">(" << child << "2 * i]);\n"
+                << "    auto b = ugraph::make_node<" << 2 * id_base << ">(" << child << "2 * i + 1]);\n"
+                << "    return ugraph::Graph(a.output<int>() >> b.input<int>());\n}\n"
+                << "using l" << l << "_t = decltype(make_l" << l << "(0));\n";
+            if (l < depth) {
+                os << "l" << l << "_t* g" << l << "[" << (node_count >> l) << "];\n";
+            }
+            os << "\n";
+            id_base *= 10;
+        }
+        os << "auto make() {\n";
+        for (std::size_t l = 1; l < depth; ++l) {
+            os << "    for (std::size_t i = 0; i < " << (node_count >> l) << "; ++i) g" << l
+                << "[i] = new l" << l << "_t(make_l" << l << "(i));\n";
+        }
+        os << "    return make_l" << depth << "(0);\n}\n" << run_graph;
+        return os.str();
+    }
+
+    std::string topology_source(const Shape& s) {
+        std::ostringstream os;
+        os << prelude;
+        os << "using topology_t = ugraph::Topology<\n";
+        for (std::size_t i = 0; i < s.edges.size(); ++i) {
+            const auto& e = s.edges[i];
+            os << "    std::pair<ugraph::NodeTag<" << s.nodes[e.src].id << ", " << module_name(s.nodes[e.src]) << ">, "
+                << "ugraph::NodeTag<" << s.nodes[e.dst].id << ", " << module_name(s.nodes[e.dst]) << ">>"
+                << (i + 1 < s.edges.size() ? ",\n" : "\n");
+        }
+        os << ">;\n\nstatic_assert(!topology_t::is_cyclic());\n";
+        os << "std::size_t first_id() { constexpr auto ids = topology_t::ids(); return ids[0]; }\n";
+        return os.str();
+    }
+
+    struct Case {
+        std::string shape;
+        std::size_t nodes;
+        std::size_t edges;
+        std::string source;
+    };
+
+    Case make_case(const std::string& shape, std::size_t n) {
+        if (shape == "nested" || shape == "deep") {
+            Case c { shape, 0, 0, {} };
+            c.source = shape == "nested" ? nested_source(n, c.nodes, c.edges) : deep_source(n, c.nodes, c.edges);
+            return c;
+        }
+        Shape s;
+        if (shape == "chain") s = make_chain(n);
+        else if (shape == "fan_in") s = make_fan_in(n);
+        else if (shape == "diamond") s = make_diamond(n);
+        else s = make_layered(n);
+        return { shape, s.nodes.size(), s.edges.size(), shape == "topology" ? topology_source(s) : graph_source(s) };
+    }
+
+    struct Measure {
+        std::string status;     // ok, failed, timeout
+        double seconds = 0.0;
+        long peak_rss_kb = 0;
+        long object_bytes = 0;
+    };
+
+    Measure compile(const std::vector<std::string>& args, const std::string& object, int timeout) {
+        Measure m;
+        std::vector<char*> argv;
+        for (const auto& a : args) argv.push_back(const_cast<char*>(a.c_str()));
+        argv.push_back(nullptr);
+
+        std::remove(object.c_str());
+        const auto start = std::chrono::steady_clock::now();
+        const pid_t pid = fork();
+        if (pid == 0) {
+            setpgid(0, 0);
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        if (pid < 0) {
+            m.status = "failed";
+            return m;
+        }
+
+        int status = 0;
+        rusage usage {};
+        bool timed_out = false;
+        for (;;) {
+            const pid_t r = wait4(pid, &status, WNOHANG, &usage);
+            if (r == pid) break;
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (!timed_out && timeout > 0 && elapsed > timeout) {
+                kill(-pid, SIGKILL);
+                kill(pid, SIGKILL);
+                timed_out = true;
+            }
+            usleep(10000);
+        }
+
+        m.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#if defined(__APPLE__)
+        m.peak_rss_kb = usage.ru_maxrss / 1024;
+#else
+        m.peak_rss_kb = usage.ru_maxrss;
+#endif
+        struct stat st {};
+        if (timed_out) {
+            m.status = "timeout";
+        }
+        else if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && stat(object.c_str(), &st) == 0) {
+            m.status = "ok";
+            m.object_bytes = static_cast<long>(st.st_size);
+        }
+        else {
+            m.status = "failed";
+        }
+        return m;
+    }
+
+    std::string compiler_version(const std::string& compiler) {
+        std::string line;
+        if (FILE* p = popen((compiler + " --version 2>/dev/null").c_str(), "r")) {
+            char buf[256];
+            if (fgets(buf, sizeof(buf), p)) line = buf;
+            pclose(p);
+        }
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        return line;
+    }
+
+    std::string json_escape(const std::string& s) {
+        std::string r;
+        for (char c : s) {
+            if (c == '"' || c == '\\') r += '\\';
+            r += c;
+        }
+        return r;
+    }
+
+    std::vector<std::string> split(const std::string& s, char sep) {
+        std::vector<std::string> r;
+        std::stringstream ss(s);
+        std::string item;
+        while (std::getline(ss, item, sep)) {
+            if (!item.empty()) r.push_back(item);
+        }
+        return r;
+    }
+
+    int usage(const char* self) {
+        std::fprintf(stderr,
+            "usage: %s --include <dir> --work <dir> --out <file.json> --compiler <cxx> [--compiler <cxx>...]\n"
+            "          [--sizes 10,50,100,250,500,1000,2000] [--shapes chain,fan_in,diamond,layered,nested,deep,topology]\n"
+            "          [--flags \"-std=c++17 -O2\"] [--timeout seconds]\n", self);
+        return 2;
+    }
+
+}
+
+int main(int argc, char** argv) {
+
+    std::string include, work, out, flags = "-std=c++17 -O2";
+    std::vector<std::string> compilers;
+    std::vector<std::string> shapes { "chain", "fan_in", "diamond", "layered", "nested", "deep", "topology" };
+    std::vector<std::size_t> sizes { 10, 50, 100, 250, 500, 1000, 2000 };
+    int timeout = 600;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (i + 1 >= argc) return usage(argv[0]);
+        const std::string v = argv[++i];
+        if (a == "--include") include = v;
+        else if (a == "--work") work = v;
+        else if (a == "--out") out = v;
+        else if (a == "--compiler") compilers.push_back(v);
+        else if (a == "--flags") flags = v;
+        else if (a == "--timeout") timeout = std::atoi(v.c_str());
+        else if (a == "--shapes") shapes = split(v, ',');
+        else if (a == "--sizes") {
+            sizes.clear();
+            for (const auto& s : split(v, ',')) sizes.push_back(std::strtoul(s.c_str(), nullptr, 10));
+        }
+        else return usage(argv[0]);
+    }
+    if (include.empty() || work.empty() || out.empty() || compilers.empty()) {
+        return usage(argv[0]);
+    }
+    std::sort(sizes.begin(), sizes.end());
+    mkdir(work.c_str(), 0755);
+
+    std::ostringstream json;
+    json << "{\n  \"flags\": \"" << json_escape(flags) << "\",\n  \"results\": [";
+    bool first = true;
+
+    for (const auto& compiler : compilers) {
+        const std::string version = compiler_version(compiler);
+        if (version.empty()) {
+            std::fprintf(stderr, "%s: not found, skipped\n", compiler.c_str());
+            continue;
+        }
+        for (const auto& shape : shapes) {
+            bool skip = false;
+            for (auto n : sizes) {
+                const Case c = make_case(shape, n);
+                const std::string base = work + "/" + shape + "_" + std::to_string(n);
+                const std::string source = base + ".cpp";
+                const std::string object = base + ".o";
+                std::ofstream(source) << c.source;
+
+                Measure m;
+                if (skip) {
+                    m.status = "skipped";
+                }
+                else {
+                    std::vector<std::string> args { compiler };
+                    for (const auto& f : split(flags, ' ')) args.push_back(f);
+                    args.insert(args.end(), { "-I" + include, "-c", source, "-o", object });
+                    m = compile(args, object, timeout);
+                    skip = m.status != "ok";
+                }
+
+                std::printf("%-10s %-9s %5zu nodes %5zu edges  %-7s %8.2f s %9ld KB %9ld B\n",
+                    compiler.c_str(), shape.c_str(), c.nodes, c.edges, m.status.c_str(), m.seconds, m.peak_rss_kb, m.object_bytes);
+                std::fflush(stdout);
+
+                json << (first ? "\n" : ",\n") << "    { "
+                    << "\"compiler\": \"" << json_escape(compiler) << "\", "
+                    << "\"version\": \"" << json_escape(version) << "\", "
+                    << "\"shape\": \"" << shape << "\", "
+                    << "\"size_class\": " << n << ", "
+                    << "\"nodes\": " << c.nodes << ", "
+                    << "\"edges\": " << c.edges << ", "
+                    << "\"status\": \"" << m.status << "\", "
+                    << "\"compile_seconds\": " << m.seconds << ", "
+                    << "\"peak_rss_kb\": " << m.peak_rss_kb << ", "
+                    << "\"object_bytes\": " << m.object_bytes << " }";
+                first = false;
+            }
+        }
+    }
+
+    json << "\n  ]\n}\n";
+    std::ofstream(out) << json.str();
+    return 0;
+}
@@ -0,0 +1,183 @@
+// Graph (modules owned by the caller, scattered on the heap) vs OwningGraph (modules stored in the
+// graph, contiguous in topological order) on a 256 node chain.
+//
+// A single 256 node graph takes too long to compile, so the chain is made of 16 graphs of 16 nodes,
+// the output of each one bound to the input of the next. The owning segments sit next to each
+// other in one vector, so the 256 modules are still laid out back to back in execution order.
+//
+// Each frame is measured twice: with warm caches, and after evicting the caches, which is what an
+// audio callback typically sees once the rest of the application has run. On Linux the LLC read
+// misses of the cold frames are counted with ugraph::PerfCounters when perf events are accessible.
+
+#include "ugraph.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+    constexpr std::size_t segment_size = 16;
+    constexpr std::size_t segment_count = 16;
+    constexpr std::size_t node_count = segment_size * segment_count;
+
+    struct Stage {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        std::array<int, 24> state {};
+        void process(ugraph::Context<Manifest>& ctx) {
+            int v = ctx.input<int>();
+            for (auto& s : state) {
+                s += v;
+                v ^= s;
+            }
+            ctx.output<int>() = v;
+        }
+    };
+
+    template<template<typename...> class graph_tpl, typename nodes_t, std::size_t... I>
+    auto make_chain_edges(nodes_t& nodes, std::index_sequence<I...>) {
+        return graph_tpl(
+            (std::get<I>(nodes).template output<int>() >> std::get<I + 1>(nodes).template input<int>())...
+        );
+    }
+
+    template<template<typename...> class graph_tpl, std::size_t... I>
+    auto make_chain(const std::array<Stage*, segment_size>& modules, std::index_sequence<I...>) {
+        auto nodes = std::make_tuple(ugraph::make_node<I + 1>(*modules[I])...);
+        return make_chain_edges<graph_tpl>(nodes, std::make_index_sequence<segment_size - 1>{});
+    }
+
+    template<template<typename...> class graph_tpl>
+    auto make_chain(const std::array<Stage*, segment_size>& modules) {
+        return make_chain<graph_tpl>(modules, std::make_index_sequence<segment_size>{});
+    }
+
+    std::vector<char> eviction(32 << 20);
+
+    void evict_caches() {
+        for (std::size_t i = 0; i < eviction.size(); i += 64) {
+            eviction[i] = static_cast<char>(eviction[i] + 1);
+        }
+    }
+
+    struct result_t {
+        double hot_ns;
+        double cold_ns;
+        long long cold_misses;
+    };
+
+    template<typename segments_t>
+    result_t measure(segments_t& segments) {
+        using clock = std::chrono::steady_clock;
+        constexpr int hot_frames = 2000;
+        constexpr int cold_frames = 200;
+
+        auto run = [&] {
+            for (auto& g : segments) {
+                g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+            }
+        };
+
+        for (int i = 0; i < hot_frames / 10; ++i) run();
+        auto t0 = clock::now();
+        for (int i = 0; i < hot_frames; ++i) run();
+        auto t1 = clock::now();
+
+        ugraph::PerfCounters counters;
+        const bool counted = counters.available(ugraph::PerfEvent::llc_misses);
+        constexpr auto llc = static_cast<std::size_t>(ugraph::PerfEvent::llc_misses);
+        double cold = 0.0;
+        long long misses = 0;
+        for (int i = 0; i < cold_frames; ++i) {
+            evict_caches();
+            auto c0 = clock::now();
+            const auto before = counters.sample();
+            run();
+            const auto after = counters.sample();
+            auto c1 = clock::now();
+            cold += std::chrono::duration<double, std::nano>(c1 - c0).count();
+            misses += static_cast<long long>(ugraph::PerfCounters::delta(before, after).values[llc]);
+        }
+
+        return {
+            std::chrono::duration<double, std::nano>(t1 - t0).count() / hot_frames,
+            cold / cold_frames,
+            counted ? misses / cold_frames : -1
+        };
+    }
+
+    void print(const char* name, const result_t& r) {
+        if (r.cold_misses >= 0) {
+            std::printf("%-12s hot %9.1f ns   cold %9.1f ns   cold LLC misses %lld\n", name, r.hot_ns, r.cold_ns, r.cold_misses);
+        }
+        else {
+            std::printf("%-12s hot %9.1f ns   cold %9.1f ns   cold LLC misses n/a\n", name, r.hot_ns, r.cold_ns);
+        }
+    }
+
+    // Chains the segments: input of the first bound to `in`, output of the last to `out`
+    template<typename graph_t, typename data_t>
+    void bind_segments(std::vector<graph_t>& segments, std::vector<data_t>& data, std::vector<int>& links, int& in, int& out) {
+        links.assign(segment_count - 1, 0);
+        for (std::size_t s = 0; s < segment_count; ++s) {
+            segments[s].init_graph_data(data[s]);
+            segments[s].template bind_input<1>(s == 0 ? in : links[s - 1]);
+            segments[s].template bind_output<segment_size>(s + 1 == segment_count ? out : links[s]);
+        }
+    }
+
+    std::array<Stage*, segment_size> segment_modules(const std::vector<std::unique_ptr<Stage>>& owned, std::size_t s) {
+        std::array<Stage*, segment_size> modules {};
+        for (std::size_t i = 0; i < segment_size; ++i) modules[i] = owned[s * segment_size + i].get();
+        return modules;
+    }
+
+}
+
+int main() {
+
+    // Scatter the caller owned modules: shuffled allocation order with unrelated blocks in between
+    std::mt19937 rng(7);
+    std::vector<std::unique_ptr<Stage>> owned(node_count);
+    std::vector<std::unique_ptr<char[]>> padding;
+    std::vector<std::size_t> order(node_count);
+    for (std::size_t i = 0; i < node_count; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    for (auto i : order) {
+        owned[i] = std::make_unique<Stage>();
+        padding.emplace_back(new char[64 + rng() % 4096]);
+    }
+
+    using graph_t = decltype(make_chain<ugraph::Graph>(segment_modules(owned, 0)));
+    using owning_t = decltype(make_chain<ugraph::OwningGraph>(segment_modules(owned, 0)));
+
+    std::vector<graph_t> scattered;
+    std::vector<owning_t> contiguous;
+    scattered.reserve(segment_count);
+    contiguous.reserve(segment_count);
+    for (std::size_t s = 0; s < segment_count; ++s) {
+        scattered.push_back(make_chain<ugraph::Graph>(segment_modules(owned, s)));
+        contiguous.push_back(make_chain<ugraph::OwningGraph>(segment_modules(owned, s)));
+    }
+
+    std::vector<graph_t::graph_data_t> scatteredData(segment_count);
+    std::vector<owning_t::graph_data_t> contiguousData(segment_count);
+    std::vector<int> scatteredLinks, contiguousLinks;
+    int scatteredIn = 1, scatteredOut = 0;
+    int contiguousIn = 1, contiguousOut = 0;
+    bind_segments(scattered, scatteredData, scatteredLinks, scatteredIn, scatteredOut);
+    bind_segments(contiguous, contiguousData, contiguousLinks, contiguousIn, contiguousOut);
+
+    std::printf("%zu nodes, %zu bytes of module state each\n", node_count, sizeof(Stage));
+    auto scatteredResult = measure(scattered);
+    auto contiguousResult = measure(contiguous);
+    print("Graph", scatteredResult);
+    print("OwningGraph", contiguousResult);
+
+    return scatteredOut == contiguousOut ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+// ScheduleSimulator predictions against real runs.
+//
+// A synthetic graph (a source fanning out to 4 chains of 4 nodes, joined by a sink) is run for
+// real: each node busy-waits for its cost. The serial run measures every node with a
+// NodeProfiler; the measured distributions then drive the simulator, whose predicted frame times
+// are compared with real level-synchronous and static-lane runs on K threads. Work stealing has
+// no real counterpart in the library and is only predicted.
+//
+// The threaded runs need K free cores to be meaningful; with fewer the real times are an upper
+// bound of what the simulator describes.
+
+#include "ugraph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    struct Stage {};
+
+    template<std::size_t id>
+    using node = ugraph::NodeTag<id, Stage>;
+
+    template<std::size_t chain>
+    using chain_edges = std::tuple<
+        std::pair<node<1>, node<10 * chain + 10>>,
+        std::pair<node<10 * chain + 10>, node<10 * chain + 11>>,
+        std::pair<node<10 * chain + 11>, node<10 * chain + 12>>,
+        std::pair<node<10 * chain + 12>, node<10 * chain + 13>>,
+        std::pair<node<10 * chain + 13>, node<2>>
+    >;
+
+    template<typename... tuples_t>
+    struct topology_from;
+
+    template<typename... tuples_t>
+    struct topology_from<std::tuple<tuples_t...>> { using type = ugraph::Topology<tuples_t...>; };
+
+    using topo_t = typename topology_from<decltype(std::tuple_cat(
+        chain_edges<0>{}, chain_edges<1>{}, chain_edges<2>{}, chain_edges<3>{}
+    ))>::type;
+
+    constexpr std::size_t node_count = topo_t::size();
+    constexpr std::size_t frames = 2000;
+
+    using clock = std::chrono::steady_clock;
+
+    std::uint64_t now_ns() { return ugraph::SteadyClock::now(); }
+
+    void spin_for(std::uint64_t ns) {
+        const auto start = now_ns();
+        while (now_ns() - start < ns) {}
+    }
+
+    // Costs in ns by topological position: chains of increasing weight, light source and sink
+    std::array<std::uint64_t, node_count> node_costs() {
+        std::array<std::uint64_t, node_count> c {};
+        const auto ids = topo_t::ids();
+        for (std::size_t i = 0; i < node_count; ++i) {
+            const std::size_t id = ids[i];
+            c[i] = id < 10 ? 2000 : 4000 + 2000 * (id / 10 - 1);
+        }
+        return c;
+    }
+
+    struct percentiles_t {
+        double p50;
+        double p99;
+    };
+
+    percentiles_t percentiles(std::vector<double> v) {
+        std::sort(v.begin(), v.end());
+        return { v[v.size() / 2], v[v.size() * 99 / 100] };
+    }
+
+    // Spin barrier for K threads, reusable across phases
+    class Barrier {
+        std::atomic<std::size_t> mCount { 0 };
+        std::atomic<std::size_t> mPhase { 0 };
+        std::size_t mThreads;
+    public:
+        explicit Barrier(std::size_t threads) : mThreads(threads) {}
+        void wait() {
+            const std::size_t phase = mPhase.load(std::memory_order_acquire);
+            if (mCount.fetch_add(1, std::memory_order_acq_rel) + 1 == mThreads) {
+                mCount.store(0, std::memory_order_relaxed);
+                mPhase.store(phase + 1, std::memory_order_release);
+            }
+            else {
+                while (mPhase.load(std::memory_order_acquire) == phase) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    template<typename body_t>
+    std::vector<double> run_threads(std::size_t workers, body_t body) {
+        std::vector<double> times(frames);
+        Barrier frame_barrier(workers);
+        std::vector<std::thread> threads;
+        std::uint64_t start = 0;
+        for (std::size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w] {
+                for (std::size_t f = 0; f < frames; ++f) {
+                    frame_barrier.wait();
+                    if (w == 0) {
+                        start = now_ns();
+                    }
+                    frame_barrier.wait();
+                    body(w, f);
+                    frame_barrier.wait();
+                    if (w == 0) {
+                        times[f] = static_cast<double>(now_ns() - start);
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        return times;
+    }
+
+    std::vector<double> real_levels(std::size_t workers, const std::array<std::uint64_t, node_count>& costs) {
+        constexpr auto levels = topo_t::levels();
+        const std::size_t level_count = *std::max_element(levels.begin(), levels.end()) + 1;
+        Barrier level_barrier(workers);
+        std::vector<std::atomic<std::size_t>> next(level_count);
+        return run_threads(workers, [&] (std::size_t w, std::size_t) {
+            if (w == 0) {
+                for (auto& n : next) {
+                    n.store(0);
+                }
+            }
+            level_barrier.wait();
+            for (std::size_t l = 0; l < level_count; ++l) {
+                // Nodes of the level are claimed in position order by the first free thread
+                for (;;) {
+                    std::size_t k = next[l].fetch_add(1);
+                    std::size_t i = 0, seen = 0;
+                    for (; i < node_count; ++i) {
+                        if (levels[i] == l && seen++ == k) {
+                            break;
+                        }
+                    }
+                    if (i == node_count) {
+                        break;
+                    }
+                    spin_for(costs[i]);
+                }
+                level_barrier.wait();
+            }
+        });
+    }
+
+    std::vector<double> real_lanes(std::size_t workers, const std::array<std::uint64_t, node_count>& costs,
+                                   const std::array<std::size_t, node_count>& lanes) {
+        const auto& adj = topo_t::adjacency();
+        constexpr auto ids = topo_t::ids();
+        std::array<std::atomic<std::size_t>, node_count> done {};
+        return run_threads(workers, [&] (std::size_t w, std::size_t f) {
+            for (std::size_t i = 0; i < node_count; ++i) {
+                if (lanes[i] != w) {
+                    continue;
+                }
+                // Wait for the predecessors of this frame
+                for (std::size_t p = 0; p < i; ++p) {
+                    const std::size_t v = adj.index_of(ids[p]);
+                    for (std::size_t e = adj.offsets[v]; e < adj.offsets[v + 1]; ++e) {
+                        if (adj.ids[adj.targets[e]] == ids[i]) {
+                            while (done[p].load(std::memory_order_acquire) != f + 1) {
+                                std::this_thread::yield();
+                            }
+                        }
+                    }
+                }
+                spin_for(costs[i]);
+                done[i].store(f + 1, std::memory_order_release);
+            }
+        });
+    }
+
+    void print(const char* name, std::size_t workers, const ugraph::ScheduleSimulator<topo_t>& sim, const percentiles_t* real) {
+        std::printf("%-14s K=%zu  predicted p50 %8.1f us  p99 %8.1f us  idle %5.1f%%",
+            name, workers, sim.quantile(0.5) / 1000.0, sim.quantile(0.99) / 1000.0, 100.0 * sim.idle_fraction());
+        if (real) {
+            std::printf("   real p50 %8.1f us  p99 %8.1f us", real->p50 / 1000.0, real->p99 / 1000.0);
+        }
+        std::printf("\n");
+    }
+
+}
+
+int main() {
+
+    const auto costs = node_costs();
+    const std::size_t cores = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::printf("%zu nodes, %zu frames, %zu hardware threads\n", node_count, frames, cores);
+
+    // Serial reference, measuring every node
+    ugraph::NodeProfiler<node_count> profiler;
+    std::vector<double> serial(frames);
+    for (std::size_t f = 0; f < frames; ++f) {
+        const auto start = now_ns();
+        for (std::size_t i = 0; i < node_count; ++i) {
+            const auto t0 = now_ns();
+            spin_for(costs[i]);
+            profiler.record(i, now_ns() - t0);
+        }
+        serial[f] = static_cast<double>(now_ns() - start);
+    }
+
+    const ugraph::MeasuredCosts<node_count, 32> measured(profiler);
+    ugraph::SimulationOptions o;
+    o.frames = 20000;
+
+    ugraph::ScheduleSimulator<topo_t> sim;
+    const auto serial_real = percentiles(serial);
+    sim.run(o, measured);
+    print("serial", 1, sim, &serial_real);
+
+    for (std::size_t workers : { std::size_t(2), std::size_t(4) }) {
+        o.workers = workers;
+
+        sim.reset();
+        o.policy = ugraph::SchedulePolicy::levels;
+        sim.run(o, measured);
+        const auto levels_real = percentiles(real_levels(workers, costs));
+        print("levels", workers, sim, &levels_real);
+
+        sim.reset();
+        o.policy = ugraph::SchedulePolicy::static_lanes;
+        sim.run(o, measured);
+        std::array<std::size_t, node_count> lanes {};
+        for (std::size_t i = 0; i < node_count; ++i) {
+            lanes[i] = sim.lane_of(i);
+        }
+        const auto lanes_real = percentiles(real_lanes(workers, costs, lanes));
+        print("static lanes", workers, sim, &lanes_real);
+
+        sim.reset();
+        o.policy = ugraph::SchedulePolicy::work_stealing;
+        o.queue_cost = 200;
+        sim.run(o, measured);
+        print("work stealing", workers, sim, nullptr);
+        o.queue_cost = 0;
+    }
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+// Pointer-bound Context vs StaticGraph vs hand written calls on the same 5 node audio chain.
+//
+// Each variant runs one frame inside a noinline function so the generated code can be read in isolation:
+//
+//   objdump -d --no-show-raw-insn -C ugraph_bench_static_binding | awk '/<run_(pointer|static|manual)/,/^$/'
+//
+// or configure with -DUGRAPH_BENCH_ASM=ON and open the .s file. run_pointer loads every port through the
+// std::array<T*, N> of its context; run_static addresses slots at fixed offsets from the graph object,
+// the same way run_manual addresses its local arrays.
+
+#include "ugraph.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+
+#if defined(_MSC_VER)
+#define UGRAPH_BENCH_NOINLINE __declspec(noinline)
+#else
+#define UGRAPH_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+    constexpr std::size_t block_size = 64;
+
+    struct Buffer {
+        float* mData = nullptr;
+        std::size_t mSize = 0;
+    };
+
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<Buffer, 0, 1> >;
+        float value = 0.f;
+        void process(float* out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) out[i] = value; }
+        template<typename context_t>
+        void process(context_t& ctx) { process(ctx.template output<Buffer>().mData, ctx.template output<Buffer>().mSize); }
+    };
+
+    struct Mix {
+        using Manifest = ugraph::Manifest< ugraph::IO<Buffer, 2, 1> >;
+        void process(const float* a, const float* b, float* out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i]; }
+        template<typename context_t>
+        void process(context_t& ctx) {
+            process(ctx.template input<Buffer>(0).mData, ctx.template input<Buffer>(1).mData,
+                    ctx.template output<Buffer>().mData, ctx.template output<Buffer>().mSize);
+        }
+    };
+
+    struct Gain {
+        using Manifest = ugraph::Manifest< ugraph::IO<Buffer, 1, 1> >;
+        float gain = 1.f;
+        void process(const float* in, float* out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * gain; }
+        template<typename context_t>
+        void process(context_t& ctx) {
+            process(ctx.template input<Buffer>().mData, ctx.template output<Buffer>().mData, ctx.template output<Buffer>().mSize);
+        }
+    };
+
+    struct Sink {
+        using Manifest = ugraph::Manifest< ugraph::IO<Buffer, 1, 0> >;
+        float last = 0.f;
+        void process(const float* in, std::size_t n) { last = in[n - 1]; }
+        template<typename context_t>
+        void process(context_t& ctx) { process(ctx.template input<Buffer>().mData, ctx.template input<Buffer>().mSize); }
+    };
+
+    struct Modules {
+        Source a { 0.25f };
+        Source b { 0.5f };
+        Mix mix;
+        Gain gain { 2.f };
+        Sink sink;
+    };
+
+    template<template<typename...> class graph_tpl>
+    auto make_graph(Modules& m) {
+        auto nA = ugraph::make_node<1>(m.a);
+        auto nB = ugraph::make_node<2>(m.b);
+        auto nMix = ugraph::make_node<3>(m.mix);
+        auto nGain = ugraph::make_node<4>(m.gain);
+        auto nSink = ugraph::make_node<5>(m.sink);
+        return graph_tpl(
+            nA.output<Buffer>() >> nMix.input<Buffer, 0>(),
+            nB.output<Buffer>() >> nMix.input<Buffer, 1>(),
+            nMix.output<Buffer>() >> nGain.input<Buffer>(),
+            nGain.output<Buffer>() >> nSink.input<Buffer>()
+        );
+    }
+
+    using pointer_graph_t = decltype(make_graph<ugraph::Graph>(std::declval<Modules&>()));
+    using static_graph_t = decltype(make_graph<ugraph::StaticGraph>(std::declval<Modules&>()));
+
+    using storage_t = std::array<std::array<float, block_size>, 3>;
+
+}
+
+UGRAPH_BENCH_NOINLINE void run_pointer(pointer_graph_t& g) {
+    g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+}
+
+UGRAPH_BENCH_NOINLINE void run_static(static_graph_t& g) {
+    g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+}
+
+// The frame size is a runtime value here as well, so all three variants compile the same loops
+UGRAPH_BENCH_NOINLINE void run_manual(Modules& m, storage_t& s, std::size_t n) {
+    m.a.process(s[0].data(), n);
+    m.b.process(s[1].data(), n);
+    m.mix.process(s[0].data(), s[1].data(), s[2].data(), n);
+    m.gain.process(s[2].data(), s[0].data(), n);
+    m.sink.process(s[0].data(), n);
+}
+
+namespace {
+
+    // Best of several rounds, so one preempted round does not decide the result
+    template<typename run_t>
+    double measure(run_t&& run, std::size_t iterations) {
+        using clock = std::chrono::steady_clock;
+        for (std::size_t i = 0; i < iterations / 16; ++i) run();
+        double best = 0.0;
+        for (int round = 0; round < 8; ++round) {
+            auto t0 = clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) run();
+            auto t1 = clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+            best = round == 0 || ns < best ? ns : best;
+        }
+        return best;
+    }
+
+}
+
+int main() {
+
+    constexpr std::size_t iterations = 50000;
+
+    Modules pointerModules, staticModules, manualModules;
+
+    storage_t pointerStorage {}, staticStorage {}, manualStorage {};
+
+    auto pointerGraph = make_graph<ugraph::Graph>(pointerModules);
+    pointer_graph_t::graph_data_t pointerData;
+    for (std::size_t i = 0; i < pointerStorage.size(); ++i) {
+        ugraph::data_at<Buffer>(pointerData, i) = Buffer { pointerStorage[i].data(), block_size };
+    }
+    pointerGraph.init_graph_data(pointerData);
+
+    auto staticGraph = make_graph<ugraph::StaticGraph>(staticModules);
+    for (std::size_t i = 0; i < static_graph_t::slot_count<Buffer>(); ++i) {
+        staticGraph.data_at<Buffer>(i) = Buffer { staticStorage[i].data(), block_size };
+    }
+
+    const double pointer_ns = measure([&] { run_pointer(pointerGraph); }, iterations);
+    const double static_ns = measure([&] { run_static(staticGraph); }, iterations);
+    const double manual_ns = measure([&] { run_manual(manualModules, manualStorage, block_size); }, iterations);
+
+    std::printf("frame ns  pointer %.1f  static %.1f  manual %.1f\n", pointer_ns, static_ns, manual_ns);
+    std::printf("ratio     pointer/manual %.3f  static/manual %.3f\n", pointer_ns / manual_ns, static_ns / manual_ns);
+
+    const bool same = pointerModules.sink.last == manualModules.sink.last && staticModules.sink.last == manualModules.sink.last;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+# Offline plans: compile a graph definition once, in a small generator, and write its resolved
+# order and port -> slot tables to a header run by ugraph::PlannedGraph.
+#
+#   ugraph_plan_gen(<name>
+#       SOURCE   <header defining the graph type>
+#       GRAPH    <graph type expression, e.g. decltype(make_graph(std::declval<Modules&>()))>
+#       HEADER   <generated header>
+#       [INCLUDES <headers declaring the module and data types, as written in #include "...">])
+#
+# Creates the target <name> producing HEADER, a struct <name> holding the plan. Every plan is
+# also attached to the ugraph_plan_gen target, which regenerates all of them.
+
+set(UGRAPH_PLAN_GEN_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+if (NOT TARGET ugraph_plan_gen)
+    add_custom_target(ugraph_plan_gen)
+endif()
+
+function(ugraph_plan_gen name)
+    cmake_parse_arguments(PLAN "" "SOURCE;GRAPH;HEADER" "INCLUDES" ${ARGN})
+    if (NOT PLAN_SOURCE OR NOT PLAN_GRAPH OR NOT PLAN_HEADER)
+        message(FATAL_ERROR "ugraph_plan_gen(${name}): SOURCE, GRAPH and HEADER are required")
+    endif()
+
+    set(PLAN_NAME ${name})
+    get_filename_component(PLAN_SOURCE ${PLAN_SOURCE} ABSOLUTE)
+    get_filename_component(PLAN_HEADER ${PLAN_HEADER} ABSOLUTE BASE_DIR ${CMAKE_CURRENT_BINARY_DIR})
+    set(include_list "")
+    foreach (inc IN LISTS PLAN_INCLUDES)
+        if (NOT include_list STREQUAL "")
+            string(APPEND include_list ", ")
+        endif()
+        string(APPEND include_list "\"${inc}\"")
+    endforeach()
+    set(PLAN_INCLUDES "${include_list}")
+
+    set(generator_src ${CMAKE_CURRENT_BINARY_DIR}/${name}_gen.cpp)
+    configure_file(${UGRAPH_PLAN_GEN_DIR}/plan_gen.cpp.in ${generator_src} @ONLY)
+
+    add_executable(${name}_gen ${generator_src})
+    target_link_libraries(${name}_gen PRIVATE ugraph)
+    get_filename_component(source_dir ${PLAN_SOURCE} DIRECTORY)
+    target_include_directories(${name}_gen PRIVATE ${source_dir})
+
+    add_custom_command(
+        OUTPUT ${PLAN_HEADER}
+        COMMAND ${name}_gen ${PLAN_HEADER}
+        DEPENDS ${name}_gen
+        COMMENT "Generating ugraph plan ${name}"
+        VERBATIM
+    )
+    add_custom_target(${name} DEPENDS ${PLAN_HEADER})
+    add_dependencies(ugraph_plan_gen ${name})
+endfunction()
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <cstddef>
+#include "ugraph.hpp"
 
 struct AudioBuff {
 
+    // Let the graph own the sample blocks backing every AudioBuff slot
+    using storage_policy = ugraph::BufferStorage<float>;
+
     AudioBuff() = default;
 
     AudioBuff(float* ptr, std::size_t s) :
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include "ugraph.hpp"
 #include "trigger.hpp"
 
@@ -14,66 +16,101 @@ struct EnvelopeGenerator {
         return mState == eOff;
     }
 
+    // All voices of a synth at once (see ugraph::Lanes), states and levels stored per lane.
+    template<std::size_t lane_count>
+    struct batch {
+
+        template<typename lane_context_t>
+        void process(lane_context_t& ctx) {
+            for (std::size_t l = 0; l < lane_count; ++l) {
+                trigger(ctx.template input<Trigger>(l), mState[l], mValue[l]);
+            }
+            for (std::size_t l = 0; l < lane_count; ++l) {
+                step(mState[l], mValue[l]);
+            }
+            for (std::size_t l = 0; l < lane_count; ++l) {
+                ctx.template output<float>(l) = mValue[l];
+            }
+        }
+
+    private:
+        std::array<uint8_t, lane_count> mState = make_off();
+        std::array<float, lane_count> mValue {};
+
+        static constexpr std::array<uint8_t, lane_count> make_off() {
+            std::array<uint8_t, lane_count> states {};
+            for (auto& s : states) s = eOff;
+            return states;
+        }
+    };
+
     void process(ugraph::Context<Manifest>& ctx) {
+        trigger(ctx.template input<Trigger>(), mState, mValue);
+        step(mState, mValue);
+        ctx.output<float>() = mValue;
+    }
 
-        switch(ctx.template input<Trigger>().mState) {
+private:
+
+    static void trigger(const Trigger& t, uint8_t& state, float& value) {
+
+        switch(t.mState) {
 
             case Trigger::eStateChange::eOn:
-                mState = eAttack;
-                mValue = 0;
+                state = eAttack;
+                value = 0;
                 break;
 
             case Trigger::eStateChange::eOff:
-                mState = eRelease;
+                state = eRelease;
                 break;
 
             default:
                 break;
         }
+    }
+
+    static void step(uint8_t& state, float& value) {
 
         constexpr float adInc = 0.5;
         constexpr float rInc = 0.005;
 
-        switch (mState) {
+        switch (state) {
 
             case eAttack:
-                mValue += adInc;
-                if (mValue >= 1.0) {
-                    mValue = 1.0;
-                    mState++;
+                value += adInc;
+                if (value >= 1.0) {
+                    value = 1.0;
+                    state++;
                 }
                 break;
 
             case eDecay:
-                mValue -= rInc;
-                if (mValue <= 0.5) {
-                    mState++;
+                value -= rInc;
+                if (value <= 0.5) {
+                    state++;
                 }
                 break;
 
             case eSustain:
-                mValue = 0.5;
+                value = 0.5;
                 break;
 
             case eRelease:
-                mValue -= rInc;
-                if (mValue <= 0) {
-                    mValue = 0;
-                    mState++;
+                value -= rInc;
+                if (value <= 0) {
+                    value = 0;
+                    state++;
                 }
                 break;
 
             default:
-                mValue = 0;
+                value = 0;
                 break;
 
         }
-
-        ctx.output<float>() = mValue;
     }
 
-private:
-
     enum eState {
         eAttack,
         eDecay,
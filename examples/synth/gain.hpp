@@ -2,6 +2,7 @@
 
 #include "ugraph.hpp"
 #include "audio_buffer.hpp"
+#include <array>
 #include <cmath>
 #include <algorithm>
 
@@ -12,6 +13,52 @@ struct Gain {
         ugraph::IO<float, 1, 0>
     >;
 
+    // All voices of a synth at once (see ugraph::Lanes): the gains are kept structure-of-arrays,
+    // contiguous across lanes, and the ramp of every lane is set up in one pass before the sample
+    // loops. That pass calls std::pow per lane, so it only vectorizes with a vector math library.
+    template<std::size_t lane_count>
+    struct batch {
+
+        template<typename lane_context_t>
+        void process(lane_context_t& ctx) {
+
+            const auto size = ctx.template output<AudioBuff>(0).size();
+            if (size == 0) return;
+
+            const auto eps = 1e-8f;
+            const float inv = 1.0f / static_cast<float>(size);
+
+            std::array<float, lane_count> target;
+            std::array<float, lane_count> start;
+            std::array<float, lane_count> step;
+
+            for (std::size_t l = 0; l < lane_count; ++l) {
+                target[l] = ctx.template input<float>(l);
+            }
+
+            for (std::size_t l = 0; l < lane_count; ++l) {
+                const bool settled = std::fabs(target[l] - mCurrentGain[l]) <= eps;
+                const float from = mCurrentGain[l] <= 0.0f ? eps : mCurrentGain[l];
+                start[l] = settled ? target[l] : from;
+                step[l] = settled ? 1.0f : std::pow(std::max(target[l], eps) / std::max(mCurrentGain[l], eps), inv);
+                mCurrentGain[l] = target[l];
+            }
+
+            for (std::size_t l = 0; l < lane_count; ++l) {
+                auto& out = ctx.template output<AudioBuff>(l);
+                auto& in = ctx.template input<AudioBuff>(l);
+                float g = start[l];
+                for (std::size_t i = 0; i < size; ++i) {
+                    out[i] = in[i] * g;
+                    g *= step[l];
+                }
+            }
+        }
+
+    private:
+        std::array<float, lane_count> mCurrentGain {};
+    };
+
     void process(ugraph::Context<Manifest>& ctx) {
 
         auto& out = ctx.template output<AudioBuff>();
@@ -15,14 +15,34 @@ struct Mixer {
         // sum inputs into output buffer
 
         auto& outBuf = ctx.template output<AudioBuff>();
-        std::size_t size = outBuf.size();
+        auto inputs = ctx.template inputs<AudioBuff>();
 
+        // the voices usually land in consecutive slots: read them as a plain array
+        if (inputs.is_contiguous()) {
+            mix(inputs.contiguous(), outBuf);
+        }
+        else {
+            mix(inputs, outBuf);
+        }
+    }
+
+private:
+
+    template<typename span_t>
+    static void mix(const span_t& inputs, AudioBuff& outBuf) {
+        const std::size_t size = outBuf.size();
+        float* out = outBuf.begin();
+
+        const float* first = inputs[0].begin();
         for (std::size_t i = 0; i < size; ++i) {
-            float sum = 0.0f;
-            for (const auto& in : ctx.template inputs<AudioBuff>()) {
-                sum += in[i];
+            out[i] = first[i];
+        }
+
+        for (std::size_t k = 1; k < input_count; ++k) {
+            const float* in = inputs[k].begin();
+            for (std::size_t i = 0; i < size; ++i) {
+                out[i] += in[i];
             }
-            outBuf[i] = sum;
         }
     }
 
@@ -14,41 +14,40 @@
 template<std::size_t voice_count>
 static auto makeGraph(
     VoiceManager<voice_count>& voiceMgr,
-    std::array<Oscillator, voice_count>& oscillators,
-    std::array<EnvelopeGenerator, voice_count>& envelopes,
-    std::array<Gain, voice_count>& gains,
+    ugraph::Lanes<Oscillator, voice_count>& oscillators,
+    ugraph::Lanes<EnvelopeGenerator, voice_count>& envelopes,
+    ugraph::Lanes<Gain, voice_count>& gains,
     Mixer<voice_count>& mixer
 ) {
-    // Stable compile-time IDs for manager, voices and mixer
+    // Stable compile-time IDs for manager, voice lanes and mixer
     constexpr std::size_t mgr_id = 8000;
-    constexpr std::size_t voice_base_id = 10000;
-    constexpr std::size_t voice_id_stride = 10;
-    constexpr std::size_t osc_offset = 0;
-    constexpr std::size_t env_offset = 1;
-    constexpr std::size_t gain_offset = 2;
+    constexpr std::size_t osc_id = 10000;
+    constexpr std::size_t env_id = 10001;
+    constexpr std::size_t gain_id = 10002;
     constexpr std::size_t mixer_id = 9000;
 
     // Single templated lambda that builds the graph for the given index sequence
     auto build_impl = [&]<std::size_t... I>(std::index_sequence<I...>) {
         auto mgr_node = ugraph::make_node<mgr_id>(voiceMgr);
 
-        auto osc_nodes = std::make_tuple(ugraph::make_node<voice_base_id + (I * voice_id_stride) + osc_offset>(oscillators[I])...);
-        auto env_nodes = std::make_tuple(ugraph::make_node<voice_base_id + (I * voice_id_stride) + env_offset>(envelopes[I])...);
-        auto gain_nodes = std::make_tuple(ugraph::make_node<voice_base_id + (I * voice_id_stride) + gain_offset>(gains[I])...);
+        // one node per voice stage, each running all the voices (lane I is voice I)
+        auto osc_node = ugraph::make_node<osc_id>(oscillators);
+        auto env_node = ugraph::make_node<env_id>(envelopes);
+        auto gain_node = ugraph::make_node<gain_id>(gains);
 
         // mixer node
         auto mix_node = ugraph::make_node<mixer_id>(mixer);
 
         // edges: manager outputs -> oscillator/env inputs
-        auto mgr_osc_edges = std::make_tuple((mgr_node.template output<Trigger, I>() >> std::get<I>(osc_nodes).template input<Trigger>())...);
-        auto mgr_env_edges = std::make_tuple((mgr_node.template output<Trigger, I>() >> std::get<I>(env_nodes).template input<Trigger>())...);
+        auto mgr_osc_edges = std::make_tuple((mgr_node.template output<Trigger, I>() >> osc_node.template input<Trigger, I>())...);
+        auto mgr_env_edges = std::make_tuple((mgr_node.template output<Trigger, I>() >> env_node.template input<Trigger, I>())...);
 
         // edges: osc + env -> gain
-        auto voice_audio_edges = std::make_tuple((std::get<I>(osc_nodes).template output<AudioBuff>() >> std::get<I>(gain_nodes).template input<AudioBuff>())...);
-        auto voice_env_edges = std::make_tuple((std::get<I>(env_nodes).template output<float>() >> std::get<I>(gain_nodes).template input<float>())...);
+        auto voice_audio_edges = std::make_tuple((osc_node.template output<AudioBuff, I>() >> gain_node.template input<AudioBuff, I>())...);
+        auto voice_env_edges = std::make_tuple((env_node.template output<float, I>() >> gain_node.template input<float, I>())...);
 
         // edges: gain outputs -> mixer inputs
-        auto mix_edges = std::make_tuple((std::get<I>(gain_nodes).template output<AudioBuff>() >> mix_node.template input<AudioBuff, I>())...);
+        auto mix_edges = std::make_tuple((gain_node.template output<AudioBuff, I>() >> mix_node.template input<AudioBuff, I>())...);
 
         auto edges = std::tuple_cat(mgr_osc_edges, mgr_env_edges, voice_audio_edges, voice_env_edges, mix_edges);
 
@@ -64,14 +63,13 @@ struct Synth {
     static constexpr std::size_t mixer_node_id = 9000;
 
     Synth() {
+        mGraph.prepare(max_buffer_size);
         mGraph.init_graph_data(mSynthGraphData);
         mGraph.bind_input<manager_node_id>(mTriggers);
         mGraph.bind_output<mixer_node_id>(mOutputBuffer);
         // Reserve triggers to avoid heap allocations on the audio thread
         mTriggers.reserve(128);
 
-        initAudioBuff();
-
         print();
     }
 
@@ -83,7 +81,7 @@ struct Synth {
 
         mOutputBuffer = { output, size };
 
-        initAudioBuff(size);
+        mGraph.resize_views(mSynthGraphData, size);
 
         if (!mGraph.all_ios_connected()) {
             // Consume/clear pending triggers even if graph isn't ready
@@ -91,7 +89,10 @@ struct Synth {
             return;
         }
 
-        mGraph.for_each(
+        // Node messages (ctx.log) go to mLog, drained off the audio thread, see log()
+        auto logAttachment = mLog.attach();
+
+        mDeadline.run(mGraph, size,
             [] (auto& n, auto& ctx) {
                 n.process(ctx);
             }
@@ -104,57 +105,43 @@ struct Synth {
         mGraph.print(std::cout);
     }
 
-private:
-
-    void initAudioBuff(std::size_t size = max_buffer_size) {
+    // Block timings against the callback deadline, readable from the UI thread
+    auto& deadline() { return mDeadline; }
 
-        // Clamp requested size to avoid out-of-bounds on fixed storage
-        if (size > max_buffer_size) {
-            size = max_buffer_size;
-        }
-
-        if (size == mPrevBufferSize) {
-            return;
-        }
+    // Messages of the nodes, e.g. drained by a ugraph::LogDrain to std::cout on the UI thread
+    auto& log() { return mLog; }
 
-        mPrevBufferSize = size;
-
-        for (std::size_t i = 0; i < mSynthBufferStorage.size(); i++) {
-            ugraph::data_at<AudioBuff>(mSynthGraphData, i) = { mSynthBufferStorage[i].data(), size };
-        }
-
-    }
+private:
 
     static constexpr std::size_t voice_count = 4;
 
     VoiceManager<voice_count> mVoiceMgr;
-    std::array<Oscillator, voice_count> mOscillators;
-    std::array<EnvelopeGenerator, voice_count> mEnvelopes;
-    std::array<Gain, voice_count> mGains;
+    ugraph::Lanes<Oscillator, voice_count> mOscillators;        // scalar lanes
+    ugraph::Lanes<EnvelopeGenerator, voice_count> mEnvelopes;   // EnvelopeGenerator::batch
+    ugraph::Lanes<Gain, voice_count> mGains;                    // Gain::batch
     Mixer<voice_count> mMixer;
 
     using synth_graph_t = 
         decltype(
             makeGraph(
                 std::declval<VoiceManager<voice_count>&>(), 
-                std::declval<std::array<Oscillator, voice_count>&>(),
-                std::declval<std::array<EnvelopeGenerator, voice_count>&>(),
-                std::declval<std::array<Gain, voice_count>&>(),
+                std::declval<ugraph::Lanes<Oscillator, voice_count>&>(),
+                std::declval<ugraph::Lanes<EnvelopeGenerator, voice_count>&>(),
+                std::declval<ugraph::Lanes<Gain, voice_count>&>(),
                 std::declval<Mixer<voice_count>&>()
             )
         );
 
-    static constexpr auto synth_buffer_count = synth_graph_t::data_count<AudioBuff>();
     static constexpr uint32_t max_buffer_size = 1024;
-    using buffer_t = std::array<float, max_buffer_size>;
-
-    std::array<buffer_t, synth_buffer_count> mSynthBufferStorage;
+    static constexpr double sample_rate = 48000.0;
 
     synth_graph_t mGraph = makeGraph(mVoiceMgr, mOscillators, mEnvelopes, mGains, mMixer);
 
     typename synth_graph_t::graph_data_t mSynthGraphData;
 
-    std::size_t mPrevBufferSize = 0;
+    ugraph::DeadlineMonitor<synth_graph_t::size()> mDeadline { sample_rate };
+
+    ugraph::Logger<256> mLog;
 
     std::vector<Trigger> mTriggers;
 
@@ -46,6 +46,9 @@ struct VoiceManager {
                         mVoiceData[freeSlotIdx].mState = true;
                         ctx.template output<Trigger>(freeSlotIdx) = { Trigger::eOn, trigger.mNoteNumber };
                     }
+                    else {
+                        ctx.log("note {} ignored: already playing or no free voice", trigger.mNoteNumber);
+                    }
 
                     break;
                 }
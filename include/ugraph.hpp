@@ -29,7 +29,24 @@
 
 #include "ugraph/node.hpp"
 #include "ugraph/graph.hpp"
+#include "ugraph/static_graph.hpp"
+#include "ugraph/planned_graph.hpp"
+#include "ugraph/plan_writer.hpp"
+#include "ugraph/lanes.hpp"
+#include "ugraph/replicate.hpp"
 #include "ugraph/topology.hpp"
 #include "ugraph/manifest.hpp"
+#include "ugraph/storage.hpp"
+#include "ugraph/arena.hpp"
+#include "ugraph/profiling.hpp"
+#include "ugraph/trace.hpp"
+#include "ugraph/perf_counters.hpp"
+#include "ugraph/deadline.hpp"
 #include "ugraph/node_tag.hpp"
 #include "ugraph/graph_printer.hpp"
+#include "ugraph/analysis.hpp"
+#include "ugraph/simulator.hpp"
+#include "ugraph/allocation_guard.hpp"
+#include "ugraph/flight_recorder.hpp"
+#include "ugraph/probes.hpp"
+#include "ugraph/log_drain.hpp"
@@ -0,0 +1,174 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace ugraph {
+
+    namespace detail {
+
+        // Heap operations of the calling thread, counted by the UGRAPH_DEFINE_ALLOCATION_HOOKS operators
+        struct allocation_counters {
+            std::uint64_t allocations;
+            std::uint64_t deallocations;
+        };
+
+        inline allocation_counters& thread_allocation_counters() {
+            static thread_local allocation_counters counters {};
+            return counters;
+        }
+
+        inline bool& allocation_hooks_flag() {
+            static bool installed = false;
+            return installed;
+        }
+
+        inline void* counted_allocate(std::size_t size) {
+            ++thread_allocation_counters().allocations;
+            return std::malloc(size ? size : 1);
+        }
+
+        inline void* counted_allocate(std::size_t size, std::align_val_t align) {
+            ++thread_allocation_counters().allocations;
+            const auto a = static_cast<std::size_t>(align);
+#if defined(_MSC_VER)
+            return _aligned_malloc(size ? size : 1, a);
+#else
+            return std::aligned_alloc(a, ((size ? size : 1) + a - 1) / a * a);
+#endif
+        }
+
+        inline void counted_free(void* p) {
+            if (p) {
+                ++thread_allocation_counters().deallocations;
+            }
+            std::free(p);
+        }
+
+        inline void counted_aligned_free(void* p) {
+            if (p) {
+                ++thread_allocation_counters().deallocations;
+            }
+#if defined(_MSC_VER)
+            _aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+
+    } // namespace detail
+
+    // True when UGRAPH_DEFINE_ALLOCATION_HOOKS is expanded somewhere in the program
+    inline bool allocation_hooks_installed() { return detail::allocation_hooks_flag(); }
+
+    // Execution policy of for_each(policy, f) checking that node calls never touch the heap: every
+    // operator new / delete made by the running thread inside a node is counted against that node
+    // (by topological position). With abort_on_violation the first one aborts the program, so that
+    // CI catches a module that started allocating. Needs UGRAPH_DEFINE_ALLOCATION_HOOKS in exactly
+    // one translation unit; meant for debug and test builds.
+    template<std::size_t node_count>
+    class AllocationGuard {
+
+        std::array<std::uint64_t, node_count> mAllocations {};
+        std::array<std::uint64_t, node_count> mDeallocations {};
+        std::uint64_t mViolations = 0;
+        bool mAbort;
+
+    public:
+
+        explicit AllocationGuard(bool abort_on_violation = false) : mAbort(abort_on_violation) {}
+
+        static constexpr std::size_t size() { return node_count; }
+
+        template<std::size_t node_index, typename F>
+        void invoke(F&& f) {
+            static_assert(node_index < node_count, "Guard is smaller than the graph");
+            const detail::allocation_counters before = detail::thread_allocation_counters();
+            f();
+            const detail::allocation_counters after = detail::thread_allocation_counters();
+            const std::uint64_t allocations = after.allocations - before.allocations;
+            const std::uint64_t deallocations = after.deallocations - before.deallocations;
+            if (allocations == 0 && deallocations == 0) {
+                return;
+            }
+            mAllocations[node_index] += allocations;
+            mDeallocations[node_index] += deallocations;
+            ++mViolations;
+            if (mAbort) {
+                std::fprintf(stderr, "ugraph: node at topological position %zu made %llu allocations and %llu deallocations\n",
+                    node_index, static_cast<unsigned long long>(allocations), static_cast<unsigned long long>(deallocations));
+                std::abort();
+            }
+        }
+
+        // Node calls that allocated or freed
+        std::uint64_t violations() const { return mViolations; }
+        bool clean() const { return mViolations == 0; }
+
+        std::uint64_t allocations(std::size_t node_index) const { return mAllocations[node_index]; }
+        std::uint64_t deallocations(std::size_t node_index) const { return mDeallocations[node_index]; }
+
+        void reset() {
+            mAllocations.fill(0);
+            mDeallocations.fill(0);
+            mViolations = 0;
+        }
+    };
+
+} // namespace ugraph
+
+// Replaces the global operator new / delete by counting versions (malloc / free underneath). Expand
+// at namespace scope in exactly one translation unit of a debug or test program.
+#define UGRAPH_DEFINE_ALLOCATION_HOOKS                                                                          \
+    void* operator new(std::size_t n) {                                                                         \
+        if (void* p = ::ugraph::detail::counted_allocate(n)) return p;                                          \
+        throw std::bad_alloc();                                                                                 \
+    }                                                                                                           \
+    void* operator new[](std::size_t n) { return ::operator new(n); }                                           \
+    void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return ::ugraph::detail::counted_allocate(n); } \
+    void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return ::ugraph::detail::counted_allocate(n); } \
+    void* operator new(std::size_t n, std::align_val_t a) {                                                     \
+        if (void* p = ::ugraph::detail::counted_allocate(n, a)) return p;                                       \
+        throw std::bad_alloc();                                                                                 \
+    }                                                                                                           \
+    void* operator new[](std::size_t n, std::align_val_t a) { return ::operator new(n, a); }                    \
+    void operator delete(void* p) noexcept { ::ugraph::detail::counted_free(p); }                              \
+    void operator delete[](void* p) noexcept { ::ugraph::detail::counted_free(p); }                            \
+    void operator delete(void* p, std::size_t) noexcept { ::ugraph::detail::counted_free(p); }                 \
+    void operator delete[](void* p, std::size_t) noexcept { ::ugraph::detail::counted_free(p); }               \
+    void operator delete(void* p, std::align_val_t) noexcept { ::ugraph::detail::counted_aligned_free(p); }    \
+    void operator delete[](void* p, std::align_val_t) noexcept { ::ugraph::detail::counted_aligned_free(p); }  \
+    void operator delete(void* p, std::size_t, std::align_val_t) noexcept { ::ugraph::detail::counted_aligned_free(p); } \
+    void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { ::ugraph::detail::counted_aligned_free(p); } \
+    static const bool ugraph_allocation_hooks_registered = (::ugraph::detail::allocation_hooks_flag() = true)
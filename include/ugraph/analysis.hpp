@@ -0,0 +1,160 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace ugraph {
+
+    namespace detail {
+
+        // Topology of a Graph / StaticGraph, or the type itself when it already is a topology
+        template<typename T, typename = void>
+        struct topology_of { using type = T; };
+
+        template<typename T>
+        struct topology_of<T, std::void_t<typename T::topology_type>> { using type = typename T::topology_type; };
+
+        // Static cost of a module: its `static constexpr cost` when it declares one, 1 otherwise
+        template<typename module_t, typename = void>
+        struct module_cost { static constexpr double value = 1.0; };
+
+        template<typename module_t>
+        struct module_cost<module_t, std::void_t<decltype(module_t::cost)>> {
+            static constexpr double value = static_cast<double>(module_t::cost);
+        };
+
+        template<typename topo_t>
+        constexpr auto static_costs() {
+            return topo_t::apply([] (auto... v) {
+                return std::array<double, sizeof...(v)> { module_cost<typename decltype(v)::module_type>::value... };
+            });
+        }
+
+    } // namespace detail
+
+    // Work / span analysis of a graph of N nodes, costs in the unit they were given in
+    template<std::size_t N>
+    struct ParallelismReport {
+        double work = 0;                                // sum of all node costs
+        double span = 0;                                // cost of the critical path
+        std::array<std::size_t, N> critical_path {};    // node ids, source first
+        std::size_t critical_length = 0;
+        std::array<std::size_t, N> level_width {};      // nodes per topological level
+        std::size_t level_count = 0;
+        std::size_t max_width = 0;
+
+        constexpr double parallelism() const { return span > 0 ? work / span : 0.0; }
+
+        // Best possible speedup on `cores` cores: work / max(work / cores, span)
+        constexpr double speedup(std::size_t cores) const {
+            if (cores == 0 || work <= 0) {
+                return 0.0;
+            }
+            const double per_core = work / static_cast<double>(cores);
+            return work / (per_core > span ? per_core : span);
+        }
+
+        constexpr bool on_critical_path(std::size_t node_id) const {
+            for (std::size_t i = 0; i < critical_length; ++i) {
+                if (critical_path[i] == node_id) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    // costs[i]: cost of the node at topological position i (measured, e.g. NodeProfiler::totals(),
+    // or any constant array). graph_t is a Graph, StaticGraph or Topology type. Usable in constant
+    // expressions.
+    template<typename graph_t, typename costs_t>
+    constexpr auto analyze_parallelism(const costs_t& costs) {
+        using topo_t = typename detail::topology_of<graph_t>::type;
+        constexpr std::size_t N = topo_t::size();
+        constexpr auto ids = topo_t::ids();
+        constexpr auto levels = topo_t::levels();
+        const auto& adj = topo_t::adjacency();
+
+        ParallelismReport<N> r {};
+        std::array<double, N> ready {};
+        std::array<double, N> finish {};
+        std::array<std::size_t, N> pred {};
+        std::size_t last = N;
+
+        for (std::size_t i = 0; i < N; ++i) {
+            pred[i] = N;
+        }
+        // Positions follow the topological order: every predecessor is final before its successors
+        for (std::size_t i = 0; i < N; ++i) {
+            const double cost = static_cast<double>(costs[i]);
+            r.work += cost;
+            finish[i] = ready[i] + cost;
+            if (last == N || finish[i] > finish[last]) {
+                last = i;
+            }
+            const std::size_t v = adj.index_of(ids[i]);
+            for (std::size_t k = adj.offsets[v]; k < adj.offsets[v + 1]; ++k) {
+                const std::size_t dst = topo_t::position_of(adj.ids[adj.targets[k]]);
+                if (pred[dst] == N || finish[i] > ready[dst]) {
+                    ready[dst] = finish[i];
+                    pred[dst] = i;
+                }
+            }
+            ++r.level_width[levels[i]];
+            if (levels[i] + 1 > r.level_count) {
+                r.level_count = levels[i] + 1;
+            }
+        }
+
+        if (last != N) {
+            r.span = finish[last];
+            std::array<std::size_t, N> reversed {};
+            for (std::size_t i = last; i != N; i = pred[i]) {
+                reversed[r.critical_length++] = ids[i];
+            }
+            for (std::size_t i = 0; i < r.critical_length; ++i) {
+                r.critical_path[i] = reversed[r.critical_length - 1 - i];
+            }
+        }
+        for (std::size_t l = 0; l < r.level_count; ++l) {
+            r.max_width = r.level_width[l] > r.max_width ? r.level_width[l] : r.max_width;
+        }
+        return r;
+    }
+
+    // Same, with the static costs of the modules (`static constexpr cost`, 1 when absent)
+    template<typename graph_t>
+    constexpr auto analyze_parallelism() {
+        using topo_t = typename detail::topology_of<graph_t>::type;
+        return analyze_parallelism<graph_t>(detail::static_costs<topo_t>());
+    }
+
+} // namespace ugraph
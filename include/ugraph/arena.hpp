@@ -0,0 +1,249 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+#include "storage.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <sys/mman.h>
+#define UGRAPH_ARENA_MMAP 1
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace ugraph {
+
+    struct ArenaOptions {
+        std::size_t capacity = std::size_t(1) << 20;
+        bool huge_pages = false;                // try explicit huge pages (MAP_HUGETLB) first
+        bool transparent_huge_pages = true;     // otherwise hint the kernel with MADV_HUGEPAGE
+        bool prefault = true;                   // touch every page at init so frames never page-fault
+        bool lock = false;                      // mlock the pages (needs CAP_IPC_LOCK or RLIMIT_MEMLOCK)
+        int numa_node = -1;                     // bind the pages to this NUMA node with mbind when >= 0
+    };
+
+    // What the arena actually obtained; every request falls back silently when the process lacks
+    // the privilege or the platform lacks the feature.
+    struct ArenaStatus {
+        bool huge_pages = false;
+        bool transparent_huge_pages = false;
+        bool prefaulted = false;
+        bool locked = false;
+        bool numa_bound = false;
+    };
+
+    // Monotonic arena backing graph data, graphs (and their contexts) and graph-owned buffers.
+    // Memory is reserved once at construction; allocations never touch the system allocator.
+    class Arena {
+
+        struct destructor_entry {
+            void (*destroy)(void*);
+            void* object;
+            destructor_entry* next;
+        };
+
+    public:
+
+        explicit Arena(const ArenaOptions& options = {}) {
+            map(options);
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator = (const Arena&) = delete;
+
+        ~Arena() {
+            for (auto* e = mDestructors; e != nullptr; e = e->next) {
+                e->destroy(e->object);
+            }
+            unmap();
+        }
+
+        // Returns nullptr when the arena is exhausted.
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+            const auto base = reinterpret_cast<std::uintptr_t>(mBase);
+            const std::uintptr_t start = (base + mUsed + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            if (mBase == nullptr || start + size > base + mCapacity) {
+                return nullptr;
+            }
+            mUsed = static_cast<std::size_t>(start + size - base);
+            return reinterpret_cast<void*>(start);
+        }
+
+        // Construct an object inside the arena; it is destroyed with the arena, in reverse order.
+        // Returns nullptr when the arena is exhausted.
+        template<typename T, typename... args_t>
+        T* create(args_t&&... args) {
+            destructor_entry* entry = nullptr;
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                entry = static_cast<destructor_entry*>(allocate(sizeof(destructor_entry), alignof(destructor_entry)));
+                if (entry == nullptr) {
+                    return nullptr;
+                }
+            }
+            void* p = allocate(sizeof(T), alignof(T) < cache_line_size ? cache_line_size : alignof(T));
+            if (p == nullptr) {
+                return nullptr;
+            }
+            T* object = ::new (p) T(std::forward<args_t>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                *entry = { [] (void* o) { static_cast<T*>(o)->~T(); }, object, mDestructors };
+                mDestructors = entry;
+            }
+            return object;
+        }
+
+        std::size_t capacity() const { return mCapacity; }
+        std::size_t used() const { return mUsed; }
+        const ArenaStatus& status() const { return mStatus; }
+
+    private:
+
+#if defined(UGRAPH_ARENA_MMAP)
+
+        static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+        static std::size_t round_up(std::size_t v, std::size_t to) { return (v + to - 1) / to * to; }
+
+        void map(const ArenaOptions& options) {
+
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            void* p = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+            if (options.huge_pages) {
+                mMappedSize = round_up(options.capacity, huge_page_size);
+                p = ::mmap(nullptr, mMappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                mStatus.huge_pages = (p != MAP_FAILED);
+            }
+#endif
+            if (p == MAP_FAILED) {
+                // Huge-page aligned length so that THP can back the whole range
+                mMappedSize = options.transparent_huge_pages ? round_up(options.capacity, huge_page_size) : round_up(options.capacity, page);
+                p = ::mmap(nullptr, mMappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED) {
+                    mMappedSize = 0;
+                    return;
+                }
+#if defined(MADV_HUGEPAGE)
+                if (options.transparent_huge_pages) {
+                    mStatus.transparent_huge_pages = (::madvise(p, mMappedSize, MADV_HUGEPAGE) == 0);
+                }
+#endif
+            }
+
+            mBase = static_cast<std::byte*>(p);
+            mCapacity = mMappedSize;
+
+            // Bind before the first touch so that pages are allocated on the requested node
+            if (options.numa_node >= 0) {
+                mStatus.numa_bound = bind_numa(options.numa_node);
+            }
+
+            if (options.prefault) {
+                const std::size_t stride = mStatus.huge_pages ? huge_page_size : page;
+                for (std::size_t off = 0; off < mMappedSize; off += stride) {
+                    static_cast<volatile std::byte*>(p)[off] = std::byte { 0 };
+                }
+                mStatus.prefaulted = true;
+            }
+
+            if (options.lock) {
+                mStatus.locked = (::mlock(p, mMappedSize) == 0);
+            }
+        }
+
+        bool bind_numa([[maybe_unused]] int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+            constexpr int mpol_bind = 2;
+            constexpr unsigned mpol_mf_move = 1u << 1;
+            constexpr std::size_t bits = sizeof(unsigned long) * 8;
+            constexpr std::size_t mask_words = 16;
+            if (static_cast<std::size_t>(node) >= bits * mask_words) {
+                return false;
+            }
+            unsigned long mask[mask_words] = {};
+            mask[node / bits] = 1ul << (node % bits);
+            return ::syscall(SYS_mbind, mBase, mMappedSize, mpol_bind, mask, bits * mask_words, mpol_mf_move) == 0;
+#else
+            return false;
+#endif
+        }
+
+        void unmap() {
+            if (mBase != nullptr) {
+                if (mStatus.locked) {
+                    ::munlock(mBase, mMappedSize);
+                }
+                ::munmap(mBase, mMappedSize);
+            }
+        }
+
+#else
+
+        void map(const ArenaOptions& options) {
+            mMappedSize = options.capacity;
+            mBase = static_cast<std::byte*>(::operator new(mMappedSize, std::align_val_t { cache_line_size }, std::nothrow));
+            if (mBase == nullptr) {
+                mMappedSize = 0;
+                return;
+            }
+            mCapacity = mMappedSize;
+            if (options.prefault) {
+                for (std::size_t off = 0; off < mMappedSize; off += 4096) {
+                    static_cast<volatile std::byte*>(mBase)[off] = std::byte { 0 };
+                }
+                mStatus.prefaulted = true;
+            }
+        }
+
+        void unmap() {
+            if (mBase != nullptr) {
+                ::operator delete(mBase, std::align_val_t { cache_line_size });
+            }
+        }
+
+#endif
+
+        std::byte* mBase = nullptr;
+        std::size_t mMappedSize = 0;
+        std::size_t mCapacity = 0;
+        std::size_t mUsed = 0;
+        destructor_entry* mDestructors = nullptr;
+        ArenaStatus mStatus;
+    };
+
+} // namespace ugraph
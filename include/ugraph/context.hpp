@@ -4,9 +4,13 @@
 #include <tuple>
 #include <type_traits>
 
+#include "log.hpp"
+
 namespace ugraph {
 
     template<typename T> struct DataSpan;
+    template<typename T> struct SlotSpan;
+    template<typename T> struct ContiguousSpan;
 
     template<typename manifest_t>
     struct Context {
@@ -71,6 +75,19 @@ namespace ugraph {
             return DataSpan<data_t>(std::get<data_array_t<data_t>>(mDataPtrsTuple).data() + input_count<data_t>(), output_count<data_t>());
         }
 
+        // Address bound to a port, null when the port is neither connected nor bound
+        template<typename data_t>
+        constexpr inline const data_t* input_ptr(std::size_t port) const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            return std::get<data_array_t<data_t>>(mDataPtrsTuple)[port];
+        }
+
+        template<typename data_t>
+        constexpr inline data_t* output_ptr(std::size_t port) const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            return std::get<data_array_t<data_t>>(mDataPtrsTuple)[input_count<data_t>() + port];
+        }
+
         template<typename data_t, std::size_t I = 0>
         constexpr inline bool has_input() const {
             static_assert(contains<data_t>(), "Type not declared in Manifest");
@@ -93,6 +110,12 @@ namespace ugraph {
             }
         }
 
+        // Real-time safe message to the logger attached to the thread, see ugraph::Logger
+        template<typename... args_t>
+        bool log(const char* format, const args_t&... args) const {
+            return ugraph::log(format, args...);
+        }
+
         template<typename data_t>
         constexpr void set_ios(const data_array_t<data_t>& inData) {
             std::get<std::decay_t<decltype(inData)>>(mDataPtrsTuple) = inData;
@@ -181,9 +204,96 @@ namespace ugraph {
             return **(mData + i);
         }
 
+        constexpr std::size_t size() const { return mSize; }
+
+        // True when the ports are bound to consecutive slots (see data_coloring), in which case
+        // data() addresses all of them as a plain array.
+        constexpr bool is_contiguous() const {
+            for (std::size_t i = 0; i < mSize; ++i) {
+                if (mData[i] == nullptr || mData[i] != mData[0] + i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr T* data() const { return mSize ? mData[0] : nullptr; }
+
+        constexpr ContiguousSpan<T> contiguous() const { return { data(), mSize }; }
+
     private:
         T* const* mData;
         std::size_t mSize;
     };
 
-}
\ No newline at end of file
+
+    // Span over graph slots selected by an index table (used by statically bound contexts).
+    template<typename T>
+    struct SlotSpan {
+
+        class iterator {
+            T* mBase;
+            const std::size_t* mSlot;
+        public:
+            constexpr iterator(T* b, const std::size_t* s) : mBase(b), mSlot(s) {}
+            constexpr T& operator*() const { return mBase[*mSlot]; }
+            constexpr iterator& operator++() { ++mSlot; return *this; }
+            constexpr bool operator!=(const iterator& other) const { return mSlot != other.mSlot; }
+        };
+
+        constexpr SlotSpan(T* base, const std::size_t* slots, std::size_t s) : mBase(base), mSlots(slots), mSize(s) {}
+
+        constexpr iterator begin() const { return iterator { mBase, mSlots }; }
+        constexpr iterator end() const { return iterator { mBase, mSlots + mSize }; }
+
+        constexpr std::size_t size() const { return mSize; }
+
+        constexpr inline T& operator [](std::size_t i) const {
+            return mBase[mSlots[i]];
+        }
+
+        constexpr bool is_contiguous() const {
+            for (std::size_t i = 0; i < mSize; ++i) {
+                if (mSlots[i] != mSlots[0] + i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr T* data() const { return mSize ? mBase + mSlots[0] : nullptr; }
+
+        constexpr ContiguousSpan<T> contiguous() const { return { data(), mSize }; }
+
+    private:
+        T* mBase;
+        const std::size_t* mSlots;
+        std::size_t mSize;
+    };
+
+
+    // Ports bound to consecutive slots: a plain pointer and a size.
+    template<typename T>
+    struct ContiguousSpan {
+
+        constexpr ContiguousSpan() = default;
+        constexpr ContiguousSpan(T* d, std::size_t s) : mData(d), mSize(s) {}
+
+        constexpr T* begin() const { return mData; }
+        constexpr T* end() const { return mData + mSize; }
+
+        constexpr std::size_t size() const { return mSize; }
+        constexpr T* data() const { return mData; }
+        constexpr bool is_contiguous() const { return true; }
+        constexpr ContiguousSpan contiguous() const { return *this; }
+
+        constexpr inline T& operator [](std::size_t i) const {
+            return mData[i];
+        }
+
+    private:
+        T* mData = nullptr;
+        std::size_t mSize = 0;
+    };
+
+}
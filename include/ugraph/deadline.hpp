@@ -0,0 +1,240 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "profiling.hpp"
+#include "storage.hpp"
+
+namespace ugraph {
+
+    // Log-linear latency histogram (HdrHistogram style): values below 2^sub_bits are exact, above
+    // every power of two is split into 2^sub_bits buckets, i.e. a relative error under 2^-sub_bits.
+    // One writer, any number of readers, no locks: buckets are relaxed atomics.
+    template<std::size_t sub_bits = 3>
+    class LatencyHistogram {
+
+        static constexpr std::size_t sub_count = std::size_t(1) << sub_bits;
+
+    public:
+
+        static constexpr std::size_t bucket_count = (64 - sub_bits + 1) * sub_count;
+
+        static constexpr std::size_t bucket_of(std::uint64_t v) {
+            std::size_t width = 0;
+            for (std::uint64_t x = v; x != 0; x >>= 1) {
+                ++width;
+            }
+            if (width <= sub_bits) {
+                return static_cast<std::size_t>(v);
+            }
+            const std::size_t shift = width - sub_bits - 1;
+            return (shift + 1) * sub_count + static_cast<std::size_t>((v >> shift) - sub_count);
+        }
+
+        // Largest value falling in a bucket
+        static constexpr std::uint64_t upper_bound(std::size_t bucket) {
+            if (bucket < sub_count) {
+                return bucket;
+            }
+            const std::size_t shift = bucket / sub_count - 1;
+            const std::uint64_t base = sub_count + bucket % sub_count;
+            return ((base + 1) << shift) - 1;
+        }
+
+        void record(std::uint64_t v) {
+            auto& b = mBuckets[bucket_of(v)];
+            b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        std::uint64_t at(std::size_t bucket) const { return mBuckets[bucket].load(std::memory_order_relaxed); }
+
+        // Upper bound of the value below which a fraction q of the records fall
+        std::uint64_t quantile(double q) const {
+            std::uint64_t total = 0;
+            for (const auto& b : mBuckets) {
+                total += b.load(std::memory_order_relaxed);
+            }
+            if (total == 0) {
+                return 0;
+            }
+            const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                seen += mBuckets[i].load(std::memory_order_relaxed);
+                if (seen >= rank) {
+                    return upper_bound(i);
+                }
+            }
+            return upper_bound(bucket_count - 1);
+        }
+
+        // Writer side only
+        void reset() {
+            for (auto& b : mBuckets) {
+                b.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+
+        std::array<std::atomic<std::uint64_t>, bucket_count> mBuckets {};
+    };
+
+    // A block that took longer than its budget
+    struct DeadlineMiss {
+        std::uint64_t frame = 0;
+        std::uint64_t elapsed = 0;          // ticks
+        std::uint64_t budget = 0;           // ticks
+        std::size_t slowest_node = 0;       // topological position
+        std::uint64_t slowest_ticks = 0;
+    };
+
+    // Measures each pass of a block processing graph against the time the block represents
+    // (frames / sample_rate), used as the for_each policy:
+    //
+    //   monitor.begin(frames);
+    //   g.for_each(monitor, f);
+    //   monitor.end();
+    //
+    // or monitor.run(g, frames, f). The audio thread is the only writer; frames(), misses(),
+    // histogram(), missed_as_slowest() and pop_miss() may be used from any other thread. The last
+    // miss_capacity misses are kept in a single producer / single consumer ring, newer misses are
+    // only counted while it is full.
+    template<std::size_t node_count, typename clock_t = SteadyClock, std::size_t miss_capacity = 64>
+    class DeadlineMonitor {
+
+        static_assert(miss_capacity > 0 && (miss_capacity & (miss_capacity - 1)) == 0, "Miss ring capacity must be a power of two");
+
+        // Writer only
+        double mTicksPerFrame;
+        std::uint64_t mStart = 0;
+        std::uint64_t mBudget = 0;
+        std::size_t mSlowest = 0;
+        std::uint64_t mSlowestTicks = 0;
+
+        alignas(cache_line_size) std::atomic<std::uint64_t> mFrames { 0 };
+        std::atomic<std::uint64_t> mMisses { 0 };
+        std::atomic<std::uint64_t> mWorst { 0 };
+        std::array<std::atomic<std::uint64_t>, node_count> mMissedAsSlowest {};
+        LatencyHistogram<> mHistogram;
+
+        alignas(cache_line_size) std::atomic<std::uint64_t> mHead { 0 };
+        alignas(cache_line_size) std::atomic<std::uint64_t> mTail { 0 };
+        std::array<DeadlineMiss, miss_capacity> mRing {};
+
+        static void bump(std::atomic<std::uint64_t>& v) {
+            v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+    public:
+
+        // ticks_per_second is the clock frequency, 1e9 for SteadyClock
+        DeadlineMonitor(double sample_rate, double ticks_per_second = 1e9) :
+            mTicksPerFrame(ticks_per_second / sample_rate) {}
+
+        static constexpr std::size_t size() { return node_count; }
+
+        void begin(std::size_t frames) {
+            mBudget = static_cast<std::uint64_t>(static_cast<double>(frames) * mTicksPerFrame);
+            mSlowest = 0;
+            mSlowestTicks = 0;
+            mStart = clock_t::now();
+        }
+
+        template<std::size_t node_index, typename F>
+        void invoke(F&& f) {
+            static_assert(node_index < node_count, "Monitor is smaller than the graph");
+            const std::uint64_t start = clock_t::now();
+            f();
+            const std::uint64_t ticks = clock_t::now() - start;
+            if (ticks > mSlowestTicks) {
+                mSlowestTicks = ticks;
+                mSlowest = node_index;
+            }
+        }
+
+        // Closes the block, returns false when it missed its deadline
+        bool end() {
+            const std::uint64_t elapsed = clock_t::now() - mStart;
+            const std::uint64_t frame = mFrames.load(std::memory_order_relaxed);
+            mHistogram.record(elapsed);
+            if (elapsed > mWorst.load(std::memory_order_relaxed)) {
+                mWorst.store(elapsed, std::memory_order_relaxed);
+            }
+            const bool met = elapsed <= mBudget;
+            if (!met) {
+                bump(mMisses);
+                bump(mMissedAsSlowest[mSlowest]);
+                const std::uint64_t head = mHead.load(std::memory_order_relaxed);
+                if (head - mTail.load(std::memory_order_acquire) < miss_capacity) {
+                    mRing[head & (miss_capacity - 1)] = DeadlineMiss { frame, elapsed, mBudget, mSlowest, mSlowestTicks };
+                    mHead.store(head + 1, std::memory_order_release);
+                }
+            }
+            mFrames.store(frame + 1, std::memory_order_release);
+            return met;
+        }
+
+        template<typename graph_t, typename F>
+        bool run(graph_t& graph, std::size_t frames, F&& f) {
+            begin(frames);
+            graph.for_each(*this, std::forward<F>(f));
+            return end();
+        }
+
+        std::uint64_t frames() const { return mFrames.load(std::memory_order_acquire); }
+        std::uint64_t misses() const { return mMisses.load(std::memory_order_relaxed); }
+        std::uint64_t worst() const { return mWorst.load(std::memory_order_relaxed); }
+
+        // Block latencies, in ticks
+        const LatencyHistogram<>& histogram() const { return mHistogram; }
+
+        // Missed blocks in which the node at this topological position ran longest
+        std::uint64_t missed_as_slowest(std::size_t node_index) const {
+            return mMissedAsSlowest[node_index].load(std::memory_order_relaxed);
+        }
+
+        // Oldest recorded miss not popped yet; the single consumer side of the ring
+        bool pop_miss(DeadlineMiss& miss) {
+            const std::uint64_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail == mHead.load(std::memory_order_acquire)) {
+                return false;
+            }
+            miss = mRing[tail & (miss_capacity - 1)];
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+} // namespace ugraph
@@ -0,0 +1,311 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "profiling.hpp"
+#include "trace.hpp"
+
+namespace ugraph {
+
+    // Snapshot type of a FlightRecorder that keeps no slot data
+    struct NoSnapshot {};
+
+    namespace detail {
+
+        template<typename stream_t, typename T, typename = void>
+        struct is_streamable : std::false_type {};
+
+        template<typename stream_t, typename T>
+        struct is_streamable<stream_t, T, std::void_t<decltype(std::declval<stream_t&>() << std::declval<const T&>())>> : std::true_type {};
+
+        template<typename T>
+        struct is_std_array : std::false_type {};
+
+        template<typename T, std::size_t N>
+        struct is_std_array<std::array<T, N>> : std::true_type {};
+
+        template<typename T>
+        struct is_std_tuple : std::false_type {};
+
+        template<typename... Ts>
+        struct is_std_tuple<std::tuple<Ts...>> : std::true_type {};
+
+        // Graph data (tuple of slot arrays) printed value by value, one line per data type
+        template<typename stream_t, typename T>
+        void write_snapshot(stream_t& out, const T& v) {
+            if constexpr (std::is_same_v<T, NoSnapshot>) {
+            }
+            else if constexpr (is_std_tuple<T>::value) {
+                std::apply([&] (const auto&... es) { ((out << "  slots", write_snapshot(out, es), out << "\n"), ...); }, v);
+            }
+            else if constexpr (is_std_array<T>::value) {
+                for (const auto& e : v) {
+                    out << " ";
+                    write_snapshot(out, e);
+                }
+            }
+            else if constexpr (is_streamable<stream_t, T>::value) {
+                out << v;
+            }
+            else {
+                out << "<" << sizeof(T) << " bytes>";
+            }
+        }
+
+    } // namespace detail
+
+    // Keeps the last frame_capacity frames of a graph: node start / duration and a copy of the slot
+    // data (snapshot_t, e.g. StaticGraph::graph_data_t) at the end of the frame. The graph thread
+    // calls begin_frame(), for_each(recorder, f), end_frame(snapshot); a frame longer than the
+    // budget, or a call to trigger(), asks for a dump. Another thread writes the dumps, see
+    // FlightRecorderWriter. The graph thread never blocks: frames run while a dump copies the ring
+    // into the dump thread's buffer are left out of it instead; formatting happens after the copy.
+    template<typename graph_t, std::size_t frame_capacity = 64, typename snapshot_t = NoSnapshot, typename clock_t = SteadyClock>
+    class FlightRecorder {
+
+        static_assert(frame_capacity > 0, "At least one frame is needed");
+
+        static constexpr std::size_t node_count = std::decay_t<graph_t>::size();
+        static constexpr auto names = detail::trace_names<std::decay_t<graph_t>>::make();
+        static constexpr auto ids = std::decay_t<graph_t>::ids();
+
+    public:
+
+        struct frame_record {
+            std::uint64_t frame = 0;
+            std::uint64_t start = 0;
+            std::uint64_t duration = 0;
+            bool overrun = false;
+            std::array<std::uint64_t, node_count> node_start {};     // ticks since the frame start
+            std::array<std::uint64_t, node_count> node_duration {};
+            snapshot_t snapshot {};
+        };
+
+        // Copy of the ring taken by dump(), owned by the dumping thread
+        using frames_t = std::array<frame_record, frame_capacity>;
+
+    private:
+
+        std::array<frame_record, frame_capacity> mFrames {};
+        std::uint64_t mFrame = 0;               // graph thread only
+        std::uint64_t mBudget = 0;
+        bool mRecording = false;
+
+        // Frames [0, mCommitted) have been recorded, the last frame_capacity of them are kept
+        alignas(cache_line_size) std::atomic<std::uint64_t> mCommitted { 0 };
+        std::atomic<bool> mWriting { false };
+        std::atomic<bool> mFrozen { false };
+        std::atomic<std::uint64_t> mSkipped { 0 };
+        alignas(cache_line_size) std::atomic<std::uint64_t> mDumpRequests { 0 };
+        std::atomic<std::uint64_t> mOverruns { 0 };
+        std::uint64_t mDumpsDone = 0;           // dump thread only
+
+        frame_record& current() { return mFrames[mFrame % frame_capacity]; }
+
+    public:
+
+        static constexpr std::size_t size() { return node_count; }
+        static constexpr std::size_t capacity() { return frame_capacity; }
+
+        // Frames longer than budget ticks request a dump; 0 disables the check
+        void set_budget(std::uint64_t ticks) { mBudget = ticks; }
+
+        void begin_frame() {
+            // Paired with the seq_cst store of mFrozen in dump(): either the dump sees this frame
+            // being written and waits for it, or this frame sees the dump and is not recorded
+            mWriting.store(true, std::memory_order_seq_cst);
+            mRecording = !mFrozen.load(std::memory_order_seq_cst);
+            if (!mRecording) {
+                mWriting.store(false, std::memory_order_release);
+                mSkipped.fetch_add(1, std::memory_order_relaxed);
+                ++mFrame;
+                return;
+            }
+            frame_record& r = current();
+            r.frame = mFrame;
+            r.start = clock_t::now();
+            r.overrun = false;
+        }
+
+        template<std::size_t node_index, typename F>
+        void invoke(F&& f) {
+            if (!mRecording) {
+                f();
+                return;
+            }
+            frame_record& r = current();
+            const std::uint64_t start = clock_t::now();
+            f();
+            r.node_start[node_index] = start - r.start;
+            r.node_duration[node_index] = clock_t::now() - start;
+        }
+
+        // Closes the frame, returns false when it overran the budget
+        bool end_frame(const snapshot_t& snapshot = snapshot_t {}) {
+            if (!mRecording) {
+                return true;
+            }
+            frame_record& r = current();
+            r.duration = clock_t::now() - r.start;
+            r.snapshot = snapshot;
+            r.overrun = mBudget != 0 && r.duration > mBudget;
+            mWriting.store(false, std::memory_order_release);
+            mCommitted.store(++mFrame, std::memory_order_release);
+            if (r.overrun) {
+                mOverruns.fetch_add(1, std::memory_order_relaxed);
+                trigger();
+            }
+            mRecording = false;
+            return !r.overrun;
+        }
+
+        template<typename F>
+        bool run(graph_t& graph, F&& f) {
+            begin_frame();
+            graph.for_each(*this, std::forward<F>(f));
+            return end_frame();
+        }
+
+        template<typename F>
+        bool run(graph_t& graph, F&& f, const snapshot_t& snapshot) {
+            begin_frame();
+            graph.for_each(*this, std::forward<F>(f));
+            return end_frame(snapshot);
+        }
+
+        // Requests a dump of the frames recorded so far, from any thread
+        void trigger() { mDumpRequests.fetch_add(1, std::memory_order_release); }
+
+        bool dump_requested() const { return mDumpRequests.load(std::memory_order_acquire) != mDumpsDone; }
+        std::uint64_t overruns() const { return mOverruns.load(std::memory_order_relaxed); }
+        // Frames left out of the ring because a dump was copying it
+        std::uint64_t skipped() const { return mSkipped.load(std::memory_order_relaxed); }
+
+        // Writes the kept frames, oldest first, and clears the pending requests. One dumping thread.
+        // The ring is only frozen while it is copied into `copy`, the frames are formatted afterwards.
+        template<typename stream_t>
+        std::size_t dump(stream_t& out, frames_t& copy) {
+            mDumpsDone = mDumpRequests.load(std::memory_order_acquire);
+
+            mFrozen.store(true, std::memory_order_seq_cst);
+            while (mWriting.load(std::memory_order_seq_cst)) {
+                std::this_thread::yield();
+            }
+            const std::uint64_t committed = mCommitted.load(std::memory_order_acquire);
+            const std::uint64_t first = committed > frame_capacity ? committed - frame_capacity : 0;
+            std::size_t count = 0;
+            for (std::uint64_t f = first; f < committed; ++f) {
+                const frame_record& r = mFrames[f % frame_capacity];
+                if (r.frame == f) {     // otherwise left out while a previous dump was copying
+                    copy[count++] = r;
+                }
+            }
+            mFrozen.store(false, std::memory_order_release);
+
+            out << "# ugraph flight recorder: " << committed - first << " frames, " << node_count << " nodes\n";
+            for (std::size_t k = 0; k < count; ++k) {
+                const frame_record& r = copy[k];
+                out << "frame " << r.frame << " start " << r.start << " duration " << r.duration
+                    << (r.overrun ? " overrun" : "") << "\n";
+                for (std::size_t i = 0; i < node_count; ++i) {
+                    out << "  " << names[i] << " " << ids[i] << " start " << r.node_start[i]
+                        << " duration " << r.node_duration[i] << "\n";
+                }
+                detail::write_snapshot(out, r.snapshot);
+            }
+            return count;
+        }
+
+        // Same, with a copy allocated for this dump
+        template<typename stream_t>
+        std::size_t dump(stream_t& out) {
+            auto copy = std::make_unique<frames_t>();
+            return dump(out, *copy);
+        }
+    };
+
+    // Background thread polling a FlightRecorder and dumping it to <prefix><n>.txt on request
+    template<typename recorder_t>
+    class FlightRecorderWriter {
+
+        recorder_t& mRecorder;
+        std::string mPrefix;
+        std::atomic<bool> mRunning { true };
+        std::atomic<std::size_t> mDumps { 0 };
+        std::unique_ptr<typename recorder_t::frames_t> mCopy = std::make_unique<typename recorder_t::frames_t>();
+        std::thread mThread;
+
+    public:
+
+        FlightRecorderWriter(recorder_t& recorder, std::string prefix,
+                             std::chrono::milliseconds period = std::chrono::milliseconds(10)) :
+            mRecorder(recorder), mPrefix(std::move(prefix)), mThread([this, period] {
+                while (mRunning.load(std::memory_order_acquire)) {
+                    poll();
+                    std::this_thread::sleep_for(period);
+                }
+                poll();
+            }) {}
+
+        ~FlightRecorderWriter() {
+            mRunning.store(false, std::memory_order_release);
+            mThread.join();
+        }
+
+        FlightRecorderWriter(const FlightRecorderWriter&) = delete;
+        FlightRecorderWriter& operator=(const FlightRecorderWriter&) = delete;
+
+        std::size_t dumps() const { return mDumps.load(std::memory_order_acquire); }
+
+    private:
+
+        void poll() {
+            if (!mRecorder.dump_requested()) {
+                return;
+            }
+            const std::size_t n = mDumps.load(std::memory_order_relaxed);
+            std::ofstream file(mPrefix + std::to_string(n) + ".txt");
+            mRecorder.dump(file, *mCopy);
+            mDumps.store(n + 1, std::memory_order_release);
+        }
+    };
+
+} // namespace ugraph
@@ -34,7 +34,9 @@
 
 #include "context.hpp"
 #include "manifest.hpp"
+#include "storage.hpp"
 #include "topology.hpp"
+#include "graph_base.hpp"
 #include "graph_printer.hpp"
 #include "type_traits/type_list.hpp"
 #include "type_traits/edge_traits.hpp"
@@ -42,8 +44,19 @@
 
 namespace ugraph {
 
-    template<typename... edges_t>
-    class Graph {
+    // A node port, referenced by node id and port index within its type.
+    struct PortRef {
+        std::size_t node_id;
+        std::size_t port;
+    };
+
+    // Graph over `edges_t`, its modules held by `module_storage_t` (see ModuleRefs / ModuleStore).
+    template<template<typename...> class module_storage_t, typename... edges_t>
+    class BasicGraph :
+        public detail::node_visitor<BasicGraph<module_storage_t, edges_t...>>,
+        public detail::edge_graph_base<BasicGraph<module_storage_t, edges_t...>, detail::data_graph_traits<edges_t...>> {
+
+        friend class detail::node_visitor<BasicGraph>;
 
         using traits = detail::data_graph_traits<edges_t...>;
         using topology_t = typename traits::topology_t;
@@ -53,7 +66,7 @@ namespace ugraph {
         using node_type_at = typename traits::template node_type_at<I>;
 
         using manifest_t = typename traits::manifest_t;
-        using modules_tuple_impl_t = typename traits::modules_tuple_t;
+        using modules_store_impl_t = typename traits::template modules_store_t<module_storage_t>;
 
         template<std::size_t... I>
         static constexpr auto make_contexts_tuple_t(std::index_sequence<I...>) ->
@@ -61,17 +74,37 @@ namespace ugraph {
 
         using contexts_tuple_t = decltype(make_contexts_tuple_t(std::make_index_sequence<topology_t::size()>{}));
 
-        template<std::size_t... I>
+        template<typename schedule_t, std::size_t... I>
         static constexpr auto make_graph_data_t(std::index_sequence<I...>) ->
             std::tuple<
             std::array<
+            typename traits::template slot_t<typename manifest_t::template type_at<I>, schedule_t>,
+            traits::template coloring_t<typename manifest_t::template type_at<I>, schedule_t>::data_count()
+            >...
+            >;
+
+        template<std::size_t... I>
+        static constexpr auto make_storage_tuple_t(std::index_sequence<I...>) ->
+            std::tuple<
+            detail::slot_storage<
             typename manifest_t::template type_at<I>,
             traits::template coloring_t<typename manifest_t::template type_at<I>>::data_count()
             >...
             >;
 
-        modules_tuple_impl_t mModules;
+        using storage_tuple_t = decltype(make_storage_tuple_t(std::make_index_sequence<manifest_t::type_count>{}));
+
+        template<std::size_t... I>
+        static constexpr bool has_views_impl(std::index_sequence<I...>) {
+            return (has_storage_policy<typename manifest_t::template type_at<I>> || ... || false);
+        }
+
+        static constexpr bool has_views = has_views_impl(std::make_index_sequence<manifest_t::type_count>{});
+
+        modules_store_impl_t mModules;
         contexts_tuple_t mContexts;
+        storage_tuple_t mStorage;
+        std::size_t mMaxViewSize = 0;
 
     public:
 
@@ -80,57 +113,87 @@ namespace ugraph {
         using vertex_types_list_public = typename topology_t::vertex_types_list_public;
         using edge_types_list_public = typename traits::flattened_edges_t;
 
-        constexpr Graph(const edges_t&... es) :
-            mModules(traits::build_modules(std::make_index_sequence<topology_t::size()>{}, es...)) {}
+        constexpr BasicGraph(const edges_t&... es) :
+            mModules(std::make_from_tuple<modules_store_impl_t>(traits::build_modules(std::make_index_sequence<topology_t::size()>{}, es...))) {}
 
         static constexpr auto ids() { return topology_t::ids(); }
         static constexpr std::size_t size() { return topology_t::size(); }
         static constexpr auto edges() { return topology_t::edges(); }
+        static constexpr const auto& adjacency() { return topology_t::adjacency(); }
+        static constexpr auto entry_ids() { return topology_t::entry_ids(); }
+        static constexpr auto exit_ids() { return topology_t::exit_ids(); }
 
         template<std::size_t node_id>
         static constexpr bool contains_node_id() { return topology_t::template has_id<node_id>(); }
 
+        // Topological position of a node id, size() when absent. Usable at run time.
+        static constexpr std::size_t position_of(std::size_t node_id) { return topology_t::position_of(node_id); }
+
         template<std::size_t node_id>
         constexpr auto module_ptr_by_id()
             -> typename topology_t::template find_type_by_id<node_id>::type::module_type* {
             static_assert(contains_node_id<node_id>(), "Invalid node id");
-            constexpr std::size_t node_index = [] () constexpr {
-                constexpr auto ids = topology_t::ids();
-                for (std::size_t i = 0; i < topology_t::size(); ++i) {
-                    if (ids[i] == node_id) {
-                        return i;
-                    }
-                }
-                return static_cast<std::size_t>(-1);
-                }();
-            static_assert(node_index != static_cast<std::size_t>(-1), "Invalid node id");
-            return std::get<node_index>(mModules);
+            return mModules.template ptr<topology_t::position_of(node_id)>();
         }
 
-        template<typename F>
-        constexpr void for_each(F&& f) {
-            for_each_impl(std::forward<F>(f), std::make_index_sequence<topology_t::size()>{});
+        // Slots of data_t in the layout of a schedule
+        template<typename data_t, typename schedule_t = SerialSchedule>
+        static constexpr std::size_t data_count() {
+            return traits::template coloring_t<data_t, schedule_t>::data_count();
         }
 
-        template<typename data_t>
-        static constexpr std::size_t data_count() {
-            return traits::template coloring_t<data_t>::data_count();
+        // Slot storage laid out for a given schedule: slots are only reused between nodes the
+        // schedule never runs at the same time, slots that it may access from different cores at
+        // once are padded to a cache line, all others stay tightly packed.
+        template<typename schedule_t>
+        using graph_data_for_t = decltype(make_graph_data_t<schedule_t>(std::make_index_sequence<manifest_t::type_count>{}));
+
+        using graph_data_t = graph_data_for_t<SerialSchedule>;
+
+        // Binds the node ports to the slots of the layout of schedule_t, e.g.
+        // init_graph_data<LevelSchedule>(data) for a graph_data_for_t<LevelSchedule>
+        template<typename schedule_t = SerialSchedule, typename graph_data_layout_t>
+        constexpr void init_graph_data(graph_data_layout_t& graph_data) {
+            static_assert(std::is_same_v<graph_data_layout_t, graph_data_for_t<schedule_t>>,
+                "Graph data layout of another schedule: use init_graph_data<schedule_t>(data)");
+            static_assert(!shares_concurrent_slots<schedule_t>(std::make_index_sequence<manifest_t::type_count>{}),
+                "Schedule step() lets nodes that run at the same time share a slot");
+            init_graph_data_impl<schedule_t>(graph_data, std::make_index_sequence<topology_t::size()>{});
+            if constexpr (has_views) {
+                resize_views(graph_data, mMaxViewSize);
+            }
+        }
+
+        // Allocate the aligned backing blocks of every slot whose data type declares a storage
+        // policy, for the layout of schedule_t. Views are sized to max_size by init_graph_data
+        // and can be shrunk per block.
+        template<typename schedule_t = SerialSchedule>
+        void prepare(std::size_t max_size) {
+            mMaxViewSize = max_size;
+            prepare_impl<schedule_t>(max_size, std::make_index_sequence<manifest_t::type_count>{});
         }
 
-        using graph_data_t = decltype(make_graph_data_t(std::make_index_sequence<manifest_t::type_count>{}));
+        // Same as prepare(max_size) with the backing blocks taken from an arena (see arena.hpp).
+        // Returns false when the arena is too small; the affected views then stay empty.
+        template<typename schedule_t = SerialSchedule, typename arena_t>
+        bool prepare(std::size_t max_size, arena_t& arena) {
+            mMaxViewSize = max_size;
+            return prepare_impl<schedule_t>(max_size, arena, std::make_index_sequence<manifest_t::type_count>{});
+        }
 
-        constexpr void init_graph_data(graph_data_t& graph_data) {
-            init_graph_data_impl(graph_data, std::make_index_sequence<topology_t::size()>{});
+        // Point every view slot at its backing block with the given size (clamped to the prepared size).
+        template<typename graph_data_layout_t>
+        void resize_views(graph_data_layout_t& graph_data, std::size_t size) {
+            if (size > mMaxViewSize) {
+                size = mMaxViewSize;
+            }
+            resize_views_impl(graph_data, size, std::make_index_sequence<manifest_t::type_count>{});
         }
 
         template<std::size_t node_id, typename data_t>
         constexpr void bind_output(data_t& data) {
-            constexpr std::size_t node_index = [] () constexpr {
-                constexpr auto ids = topology_t::ids();
-                for (std::size_t i = 0; i < topology_t::size(); ++i) if (ids[i] == node_id) return i;
-                return static_cast<std::size_t>(-1);
-                }();
-            static_assert(node_index != static_cast<std::size_t>(-1), "Invalid node id");
+            constexpr std::size_t node_index = topology_t::position_of(node_id);
+            static_assert(node_index != topology_t::size(), "Invalid node id");
             using node_type = node_type_at<node_index>;
             using node_manifest = typename node_type::module_type::Manifest;
             static_assert(node_manifest::template contains<data_t>, "Type not declared in node Manifest");
@@ -149,12 +212,8 @@ namespace ugraph {
         template<std::size_t node_id, std::size_t output_index, typename data_t>
         constexpr void bind_output_at(data_t& data) {
 
-            constexpr std::size_t node_index = [] () constexpr {
-                constexpr auto ids = topology_t::ids();
-                for (std::size_t i = 0; i < topology_t::size(); ++i) if (ids[i] == node_id) return i;
-                return static_cast<std::size_t>(-1);
-                }();
-            static_assert(node_index != static_cast<std::size_t>(-1), "Invalid node id");
+            constexpr std::size_t node_index = topology_t::position_of(node_id);
+            static_assert(node_index != topology_t::size(), "Invalid node id");
             using node_type = node_type_at<node_index>;
             using node_manifest = typename node_type::module_type::Manifest;
             static_assert(node_manifest::template contains<data_t>, "Type not declared in node Manifest");
@@ -177,12 +236,8 @@ namespace ugraph {
 
         template<std::size_t node_id, typename data_t>
         constexpr void bind_input(data_t& data) {
-            constexpr std::size_t node_index = [] () constexpr {
-                constexpr auto ids = topology_t::ids();
-                for (std::size_t i = 0; i < topology_t::size(); ++i) if (ids[i] == node_id) return i;
-                return static_cast<std::size_t>(-1);
-                }();
-            static_assert(node_index != static_cast<std::size_t>(-1), "Invalid node id");
+            constexpr std::size_t node_index = topology_t::position_of(node_id);
+            static_assert(node_index != topology_t::size(), "Invalid node id");
             using node_type = node_type_at<node_index>;
             using node_manifest = typename node_type::module_type::Manifest;
             static_assert(node_manifest::template contains<data_t>, "Type not declared in node Manifest");
@@ -201,12 +256,8 @@ namespace ugraph {
         template<std::size_t node_id, std::size_t input_index, typename data_t>
         constexpr void bind_input_at(data_t& data) {
 
-            constexpr std::size_t node_index = [] () constexpr {
-                constexpr auto ids = topology_t::ids();
-                for (std::size_t i = 0; i < topology_t::size(); ++i) if (ids[i] == node_id) return i;
-                return static_cast<std::size_t>(-1);
-                }();
-            static_assert(node_index != static_cast<std::size_t>(-1), "Invalid node id");
+            constexpr std::size_t node_index = topology_t::position_of(node_id);
+            static_assert(node_index != topology_t::size(), "Invalid node id");
             using node_type = node_type_at<node_index>;
             using node_manifest = typename node_type::module_type::Manifest;
             static_assert(node_manifest::template contains<data_t>, "Type not declared in node Manifest");
@@ -224,42 +275,105 @@ namespace ugraph {
             ctx.template set_input_ptr<input_index, data_t>(&data);
         }
 
+        // Ports of data_t left unconnected by the edges, i.e. the ports to bind from outside the
+        // graph, in topological node order then port order.
+        template<typename data_t>
+        static constexpr auto unconnected_inputs() {
+            constexpr std::size_t count = collect_unconnected<data_t, false>(nullptr, std::make_index_sequence<topology_t::size()>{});
+            std::array<PortRef, count> refs {};
+            collect_unconnected<data_t, false>(refs.data(), std::make_index_sequence<topology_t::size()>{});
+            return refs;
+        }
+
+        template<typename data_t>
+        static constexpr auto unconnected_outputs() {
+            constexpr std::size_t count = collect_unconnected<data_t, true>(nullptr, std::make_index_sequence<topology_t::size()>{});
+            std::array<PortRef, count> refs {};
+            collect_unconnected<data_t, true>(refs.data(), std::make_index_sequence<topology_t::size()>{});
+            return refs;
+        }
+
         constexpr bool all_ios_connected() const {
             return std::apply([] (auto& ... ctxs) { return (ctxs.all_ios_connected() && ...); }, mContexts);
         }
 
-        template<typename stream_t>
-        void print(stream_t& stream, const std::string_view& inGraphName = "") const {
-            ugraph::print_graph<topology_t>(stream, inGraphName);
+    private:
+
+        template<typename data_t, std::size_t I, bool outputs>
+        static constexpr std::size_t node_port_count() {
+            using node_manifest = typename node_type_at<I>::module_type::Manifest;
+            if constexpr (!node_manifest::template contains<data_t>) {
+                return 0;
+            }
+            else if constexpr (outputs) {
+                return node_manifest::template output_count<data_t>();
+            }
+            else {
+                return node_manifest::template input_count<data_t>();
+            }
         }
 
-        template<typename stream_t>
-        void print_pipeline(stream_t& stream, const std::string_view& inGraphName = "") const {
-            ugraph::print_pipeline<topology_t>(stream, inGraphName);
+        template<typename data_t, std::size_t I, bool outputs, std::size_t... ps>
+        static constexpr void collect_unconnected_at(PortRef* refs, std::size_t& count, std::index_sequence<ps...>) {
+            constexpr auto node_ids = topology_t::ids();
+            constexpr std::array<bool, sizeof...(ps) + 1> open {
+                ((outputs
+                    ? traits::template output_index_for<data_t, I, ps>()
+                    : traits::template input_index_for<data_t, I, ps>()) == traits::invalid_index)...,
+                false
+            };
+            for (std::size_t p = 0; p < sizeof...(ps); ++p) {
+                if (open[p]) {
+                    if (refs) {
+                        refs[count] = PortRef { node_ids[I], p };
+                    }
+                    ++count;
+                }
+            }
         }
 
-    private:
+        template<typename data_t, bool outputs, std::size_t... I>
+        static constexpr std::size_t collect_unconnected(PortRef* refs, std::index_sequence<I...>) {
+            std::size_t count = 0;
+            (collect_unconnected_at<data_t, I, outputs>(refs, count, std::make_index_sequence<node_port_count<data_t, I, outputs>()>{}), ...);
+            return count;
+        }
 
         template<std::size_t I, typename F>
         constexpr void for_each_at(F&& f) {
-            f(*std::get<I>(mModules), std::get<I>(mContexts));
+            f(mModules.template get<I>(), std::get<I>(mContexts));
+        }
+
+        template<typename schedule_t, std::size_t... I>
+        static constexpr bool shares_concurrent_slots(std::index_sequence<I...>) {
+            return (traits::template shares_concurrent_slots<typename manifest_t::template type_at<I>, schedule_t>() || ... || false);
+        }
+
+        template<typename schedule_t, std::size_t... I>
+        void prepare_impl(std::size_t max_size, std::index_sequence<I...>) {
+            (std::get<I>(mStorage).allocate(max_size, data_count<typename manifest_t::template type_at<I>, schedule_t>()), ...);
+        }
+
+        template<typename schedule_t, typename arena_t, std::size_t... I>
+        bool prepare_impl(std::size_t max_size, arena_t& arena, std::index_sequence<I...>) {
+            return (std::get<I>(mStorage).allocate(max_size, arena, data_count<typename manifest_t::template type_at<I>, schedule_t>()) & ... & true);
         }
 
-        template<typename F, std::size_t... I>
-        constexpr void for_each_impl(F&& f, std::index_sequence<I...>) {
-            (for_each_at<I>(std::forward<F>(f)), ...);
+        template<typename graph_data_layout_t, std::size_t... I>
+        void resize_views_impl(graph_data_layout_t& graph_data, std::size_t size, std::index_sequence<I...>) {
+            (std::get<I>(mStorage).wire(std::get<I>(graph_data), size), ...);
         }
 
-        template<std::size_t node_index, std::size_t... tidx>
-        constexpr void init_node_types(graph_data_t& graph_data, std::index_sequence<tidx...>) {
+        template<typename schedule_t, std::size_t node_index, typename graph_data_layout_t, std::size_t... tidx>
+        constexpr void init_node_types(graph_data_layout_t& graph_data, std::index_sequence<tidx...>) {
             using node_type = node_type_at<node_index>;
             using node_manifest = typename node_type::module_type::Manifest;
             auto& ctx = std::get<node_index>(mContexts);
-            (init_type<node_index, typename node_manifest::template type_at<tidx>>(graph_data, ctx), ...);
+            (init_type<schedule_t, node_index, typename node_manifest::template type_at<tidx>>(graph_data, ctx), ...);
         }
 
-        template<std::size_t node_index, typename data_t, typename ctx_t>
-        constexpr void init_type(graph_data_t& graph_data, ctx_t& ctx) {
+        template<typename schedule_t, std::size_t node_index, typename data_t, typename graph_data_layout_t, typename ctx_t>
+        constexpr void init_type(graph_data_layout_t& graph_data, ctx_t& ctx) {
             using node_type = node_type_at<node_index>;
             using node_manifest = typename node_type::module_type::Manifest;;
             constexpr std::size_t manifest_index = manifest_t::template index<data_t>();
@@ -267,45 +381,45 @@ namespace ugraph {
             auto& arr = std::get<manifest_index>(graph_data);
 
             constexpr std::size_t in_count = node_manifest::template input_count<data_t>();
-            init_inputs_impl<node_index, data_t>(ctx, arr, std::make_index_sequence<in_count>{});
+            init_inputs_impl<schedule_t, node_index, data_t>(ctx, arr, std::make_index_sequence<in_count>{});
 
             constexpr std::size_t out_count = node_manifest::template output_count<data_t>();
-            init_outputs_impl<node_index, data_t>(ctx, arr, std::make_index_sequence<out_count>{});
+            init_outputs_impl<schedule_t, node_index, data_t>(ctx, arr, std::make_index_sequence<out_count>{});
         }
 
-        template<std::size_t node_index, typename data_t, typename ctx_t, std::size_t... ps>
+        template<typename schedule_t, std::size_t node_index, typename data_t, typename ctx_t, typename arr_t, std::size_t... ps>
         constexpr void init_inputs_impl(
             ctx_t& ctx,
-            std::array<data_t, traits::template coloring_t<data_t>::data_count()>& arr,
+            arr_t& arr,
             std::index_sequence<ps...>
         ) {
             (ctx.template set_input_ptr<ps, data_t>(
-                (traits::template input_index_for<data_t, node_index, ps>() != traits::invalid_index)
-                ? &arr[traits::template input_index_for<data_t, node_index, ps>()]
+                (traits::template input_index_for<data_t, node_index, ps, schedule_t>() != traits::invalid_index)
+                ? &detail::slot_value(arr[traits::template input_index_for<data_t, node_index, ps, schedule_t>()])
                 : nullptr
             ), ...);
         }
 
-        template<std::size_t node_index, typename data_t, typename ctx_t, std::size_t... ps>
+        template<typename schedule_t, std::size_t node_index, typename data_t, typename ctx_t, typename arr_t, std::size_t... ps>
         constexpr void init_outputs_impl(
             ctx_t& ctx,
-            std::array<data_t, traits::template coloring_t<data_t>::data_count()>& arr,
+            arr_t& arr,
             std::index_sequence<ps...>
         ) {
             (ctx.template set_output_ptr<ps, data_t>(
-                (traits::template output_index_for<data_t, node_index, ps>() != traits::invalid_index)
-                ? &arr[traits::template output_index_for<data_t, node_index, ps>()]
+                (traits::template output_index_for<data_t, node_index, ps, schedule_t>() != traits::invalid_index)
+                ? &detail::slot_value(arr[traits::template output_index_for<data_t, node_index, ps, schedule_t>()])
                 : nullptr
             ), ...);
         }
 
-        template<std::size_t... Is>
+        template<typename schedule_t, typename graph_data_layout_t, std::size_t... Is>
         constexpr void init_graph_data_impl(
-            graph_data_t& graph_data,
+            graph_data_layout_t& graph_data,
             std::index_sequence<Is...>
         ) {
             (
-                init_node_types<Is>(
+                init_node_types<schedule_t, Is>(
                     graph_data,
                     std::make_index_sequence<node_type_at<Is>::module_type::Manifest::type_count>{}
                 ), ...
@@ -314,13 +428,28 @@ namespace ugraph {
 
     };
 
+    // Graph over modules owned by the caller.
+    template<typename... edges_t>
+    class Graph : public BasicGraph<ModuleRefs, edges_t...> {
+    public:
+        using BasicGraph<ModuleRefs, edges_t...>::BasicGraph;
+    };
+
+    // Graph owning copies of its modules, stored contiguously in topological order and
+    // cache-line aligned. Use module_ptr_by_id to reach the owned instances.
+    template<typename... edges_t>
+    class OwningGraph : public BasicGraph<ModuleStore, edges_t...> {
+    public:
+        using BasicGraph<ModuleStore, edges_t...>::BasicGraph;
+    };
+
     template<typename data_t, typename tuple_t, std::size_t I = 0, bool InRange = (I < std::tuple_size_v<tuple_t>)>
     struct tuple_index_of_type_impl;
 
     template<typename data_t, typename tuple_t, std::size_t I>
     struct tuple_index_of_type_impl<data_t, tuple_t, I, true> {
         using arr_t = std::tuple_element_t<I, tuple_t>;
-        using elem_t = typename arr_t::value_type;
+        using elem_t = typename detail::slot_element<typename arr_t::value_type>::type;
         static constexpr std::size_t value = std::is_same_v<data_t, elem_t>
             ? I
             : tuple_index_of_type_impl<data_t, tuple_t, I + 1>::value;
@@ -336,10 +465,13 @@ namespace ugraph {
         constexpr std::size_t index = tuple_index_of_type_impl<data_t, graph_data_t>::value;
         static_assert(index != static_cast<std::size_t>(-1), "Type not found in graph_data_t");
         auto& arr = std::get<index>(graph_data);
-        return arr[i];
+        return detail::slot_value(arr[i]);
     }
 
     template<typename E0, typename... ERest>
     Graph(E0 const&, ERest const&...) -> Graph<std::decay_t<E0>, std::decay_t<ERest>...>;
 
+    template<typename E0, typename... ERest>
+    OwningGraph(E0 const&, ERest const&...) -> OwningGraph<std::decay_t<E0>, std::decay_t<ERest>...>;
+
 } // namespace ugraph
@@ -0,0 +1,112 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "graph_printer.hpp"
+
+namespace ugraph {
+
+    namespace detail {
+
+        // Node iteration shared by the graph classes. derived_t provides size() and a for_each_at<I>(f)
+        // calling f(module, context) on the node at topological position I (befriend node_visitor).
+        template<typename derived_t>
+        class node_visitor {
+        public:
+
+            template<typename F>
+            constexpr void for_each(F&& f) {
+                for_each_impl(std::forward<F>(f), std::make_index_sequence<derived_t::size()>{});
+            }
+
+            // Runs every node call through policy.invoke<topological position>(call), see profiling.hpp
+            template<typename policy_t, typename F>
+            constexpr void for_each(policy_t& policy, F&& f) {
+                for_each_impl(policy, std::forward<F>(f), std::make_index_sequence<derived_t::size()>{});
+            }
+
+        private:
+
+            template<typename F, std::size_t... I>
+            constexpr void for_each_impl(F&& f, std::index_sequence<I...>) {
+                (static_cast<derived_t&>(*this).template for_each_at<I>(std::forward<F>(f)), ...);
+            }
+
+            template<typename policy_t, typename F, std::size_t... I>
+            constexpr void for_each_impl(policy_t& policy, F&& f, std::index_sequence<I...>) {
+                (policy.template invoke<I>([&] { static_cast<derived_t&>(*this).template for_each_at<I>(f); }), ...);
+            }
+        };
+
+        // Port queries and printers of the graphs built from edges (Graph, OwningGraph, StaticGraph)
+        template<typename derived_t, typename traits>
+        class edge_graph_base {
+
+            using topology_t = typename traits::topology_t;
+
+        public:
+
+            // Slot shared by a connected output port in the serial layout, data_count<data_t>() when
+            // the port is not connected
+            template<typename data_t, std::size_t node_id, std::size_t port>
+            static constexpr std::size_t output_slot() {
+                static_assert(topology_t::template has_id<node_id>(), "Invalid node id");
+                constexpr std::size_t index = traits::template output_index_for<data_t, topology_t::position_of(node_id), port>();
+                return index != traits::invalid_index ? index : traits::template coloring_t<data_t>::data_count();
+            }
+
+            template<typename stream_t>
+            void print(stream_t& stream, const std::string_view& inGraphName = "") const {
+                ugraph::print_graph<topology_t>(stream, inGraphName);
+            }
+
+            template<typename stream_t>
+            void print_pipeline(stream_t& stream, const std::string_view& inGraphName = "") const {
+                ugraph::print_pipeline<topology_t>(stream, inGraphName);
+            }
+
+            // costs[i]: measured cost of the node at topological position i, e.g. NodeProfiler::totals()
+            template<typename stream_t, typename costs_t>
+            void print_profile(stream_t& stream, const costs_t& costs, const std::string_view& inGraphName = "") const {
+                ugraph::print_profile<derived_t>(stream, costs, inGraphName);
+            }
+
+            template<typename stream_t, typename costs_t>
+            void print_profile_dot(stream_t& stream, const costs_t& costs, const std::string_view& inGraphName = "") const {
+                ugraph::print_profile_dot<derived_t>(stream, costs, inGraphName);
+            }
+        };
+
+    } // namespace detail
+
+} // namespace ugraph
@@ -27,10 +27,14 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <string_view>
 #include <type_traits>
 
+#include "analysis.hpp"
+#include "type_traits/type_list.hpp"
+
 namespace ugraph {
 
     template<typename graph_t, typename stream_t>
@@ -39,6 +43,16 @@ namespace ugraph {
     template<typename graph_t, typename stream_t>
     void print_pipeline(stream_t& stream, const std::string_view& inGraphName = "");
 
+    // Graph annotated with measured costs (costs[i] for the node at topological position i): nodes
+    // are shaded by their share of the total, edges labelled with data type, slot and size, and
+    // the most expensive path is highlighted. graph_t is a Graph or StaticGraph type.
+    template<typename graph_t, typename stream_t, typename costs_t>
+    void print_profile(stream_t& stream, const costs_t& costs, const std::string_view& inGraphName = "");
+
+    // Same as print_profile, in Graphviz DOT
+    template<typename graph_t, typename stream_t, typename costs_t>
+    void print_profile_dot(stream_t& stream, const costs_t& costs, const std::string_view& inGraphName = "");
+
 
 
     namespace {
@@ -202,6 +216,133 @@ namespace ugraph {
                 }
             );
         }
+
+        // One flattened edge of a graph, endpoints by topological position
+        struct profile_edge {
+            std::size_t src;
+            std::size_t dst;
+            std::size_t src_port;
+            std::size_t dst_port;
+            std::size_t slot;
+            std::size_t bytes;
+            std::string_view type;
+        };
+
+        template<typename graph_t, typename edge_t>
+        constexpr profile_edge make_profile_edge() {
+            using src_t = typename edge_t::first_type;
+            using dst_t = typename edge_t::second_type;
+            using data_t = typename src_t::data_type;
+            constexpr std::size_t src_id = src_t::node_type::id();
+            return profile_edge {
+                graph_t::position_of(src_id),
+                graph_t::position_of(dst_t::node_type::id()),
+                src_t::index(),
+                dst_t::index(),
+                graph_t::template output_slot<data_t, src_id, src_t::index()>(),
+                sizeof(data_t),
+                type_name<data_t>()
+            };
+        }
+
+        template<std::size_t N>
+        struct profile_edges {
+            std::array<profile_edge, N> edges {};
+            std::size_t count = 0;
+        };
+
+        // The flattened edge list repeats the inner edges of a nested graph once per outer edge
+        // reaching it: keep the first of each. Ports and slots are numbered per data type, so
+        // the type is part of the key.
+        template<typename graph_t, typename... edges_t>
+        constexpr auto make_profile_edges(detail::type_list<edges_t...>) {
+            constexpr std::size_t N = sizeof...(edges_t);
+            const profile_edge all[N + 1] = { make_profile_edge<graph_t, edges_t>()..., profile_edge {} };
+            profile_edges<N> r {};
+            for (std::size_t k = 0; k < N; ++k) {
+                bool seen = false;
+                for (std::size_t j = 0; j < r.count; ++j) {
+                    const auto& e = r.edges[j];
+                    seen = seen || (e.src == all[k].src && e.dst == all[k].dst && e.src_port == all[k].src_port &&
+                                    e.dst_port == all[k].dst_port && e.type == all[k].type);
+                }
+                if (!seen) {
+                    r.edges[r.count++] = all[k];
+                }
+            }
+            return r;
+        }
+
+        // Costs, shares and critical path of a graph, by topological position
+        template<typename graph_t>
+        struct profile_view {
+            static constexpr std::size_t node_count = graph_t::size();
+            static constexpr auto ids = graph_t::ids();
+            static constexpr auto unique_edges = make_profile_edges<graph_t>(typename graph_t::edge_types_list_public {});
+            static constexpr std::size_t edge_count = unique_edges.count;
+            static constexpr const auto& edges = unique_edges.edges;
+
+            std::array<double, node_count> cost {};
+            std::array<bool, node_count> critical {};
+            std::array<std::size_t, node_count> pred {};
+            double total = 0;
+            double max = 0;
+
+            template<typename costs_t>
+            explicit profile_view(const costs_t& costs) {
+                for (std::size_t i = 0; i < node_count; ++i) {
+                    cost[i] = static_cast<double>(costs[i]);
+                    total += cost[i];
+                    max = cost[i] > max ? cost[i] : max;
+                    pred[i] = node_count;
+                }
+                const auto report = analyze_parallelism<graph_t>(cost);
+                for (std::size_t k = 0; k < report.critical_length; ++k) {
+                    const std::size_t i = graph_t::position_of(report.critical_path[k]);
+                    critical[i] = true;
+                    if (k > 0) {
+                        pred[i] = graph_t::position_of(report.critical_path[k - 1]);
+                    }
+                }
+            }
+
+            bool critical_edge(const profile_edge& e) const { return critical[e.dst] && pred[e.dst] == e.src; }
+
+            double share(std::size_t i) const { return total > 0 ? cost[i] / total : 0.0; }
+
+            // White for free nodes, full red for the most expensive one
+            unsigned char shade(std::size_t i) const {
+                return static_cast<unsigned char>(max > 0 ? 255.0 * (1.0 - cost[i] / max) + 0.5 : 255.0);
+            }
+        };
+
+        template<typename stream_t>
+        void print_fill(stream_t& stream, unsigned char shade) {
+            constexpr char digits[] = "0123456789abcdef";
+            const char hex[2] = { digits[shade >> 4], digits[shade & 0xf] };
+            stream << "#ff" << hex[0] << hex[1] << hex[0] << hex[1];
+        }
+
+        // Share in percent with one decimal, without depending on the stream formatting state
+        template<typename stream_t>
+        void print_share(stream_t& stream, double share) {
+            const auto tenths = static_cast<unsigned long>(share * 1000.0 + 0.5);
+            stream << tenths / 10 << "." << tenths % 10 << "%";
+        }
+
+        template<typename stream_t>
+        void print_edge_label(stream_t& stream, const profile_edge& e) {
+            stream << e.type << " #" << e.slot << ", " << e.bytes << " B";
+        }
+
+        // Display names of the nodes of a graph or topology, by topological position
+        template<typename graph_t>
+        constexpr auto node_names() {
+            using topo_t = typename printer_topology<graph_t>::type;
+            return topo_t::apply([] (auto... v) {
+                return std::array<std::string_view, sizeof...(v)> { node_name<decltype(v)>()... };
+            });
+        }
     }
 
     template<typename graph_t, typename stream_t>
@@ -254,4 +395,67 @@ namespace ugraph {
         print_footer(stream, inGraphName);
     }
 
+    template<typename graph_t, typename stream_t, typename costs_t>
+    void print_profile(stream_t& stream, const costs_t& costs, const std::string_view& inGraphName) {
+        using view_t = profile_view<graph_t>;
+        constexpr auto names = node_names<graph_t>();
+        const view_t view(costs);
+
+        print_header(stream, inGraphName);
+        for (std::size_t i = 0; i < view_t::node_count; ++i) {
+            stream << view_t::ids[i] << "(\"" << names[i] << " " << view_t::ids[i] << "<br/>";
+            print_share(stream, view.share(i));
+            stream << "\")\n";
+            stream << "style " << view_t::ids[i] << " fill:";
+            print_fill(stream, view.shade(i));
+            if (view.critical[i]) {
+                stream << ",stroke:#d00000,stroke-width:3px";
+            }
+            stream << "\n";
+        }
+        for (std::size_t k = 0; k < view_t::edge_count; ++k) {
+            const auto& e = view_t::edges[k];
+            stream << view_t::ids[e.src] << " -->|\"";
+            print_edge_label(stream, e);
+            stream << "\"| " << view_t::ids[e.dst] << "\n";
+            if (view.critical_edge(e)) {
+                stream << "linkStyle " << k << " stroke:#d00000,stroke-width:3px\n";
+            }
+        }
+        print_footer(stream, inGraphName);
+    }
+
+    template<typename graph_t, typename stream_t, typename costs_t>
+    void print_profile_dot(stream_t& stream, const costs_t& costs, const std::string_view& inGraphName) {
+        using view_t = profile_view<graph_t>;
+        constexpr auto names = node_names<graph_t>();
+        const view_t view(costs);
+
+        stream << "digraph \"" << inGraphName << "\" {\n";
+        stream << "rankdir=LR;\n";
+        stream << "node [shape=box, style=filled];\n";
+        for (std::size_t i = 0; i < view_t::node_count; ++i) {
+            stream << "n" << view_t::ids[i] << " [label=\"" << names[i] << " " << view_t::ids[i] << "\\n";
+            print_share(stream, view.share(i));
+            stream << "\", fillcolor=\"";
+            print_fill(stream, view.shade(i));
+            stream << "\"";
+            if (view.critical[i]) {
+                stream << ", color=\"#d00000\", penwidth=3";
+            }
+            stream << "];\n";
+        }
+        for (std::size_t k = 0; k < view_t::edge_count; ++k) {
+            const auto& e = view_t::edges[k];
+            stream << "n" << view_t::ids[e.src] << " -> n" << view_t::ids[e.dst] << " [label=\"";
+            print_edge_label(stream, e);
+            stream << "\"";
+            if (view.critical_edge(e)) {
+                stream << ", color=\"#d00000\", penwidth=3";
+            }
+            stream << "];\n";
+        }
+        stream << "}\n";
+    }
+
 } // namespace ugraph
\ No newline at end of file
@@ -0,0 +1,219 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "context.hpp"
+#include "manifest.hpp"
+#include "storage.hpp"
+
+namespace ugraph {
+
+    namespace detail {
+
+        template<typename manifest_t, std::size_t lane_count>
+        struct lanes_manifest;
+
+        // Every IO of the lane manifest has lane_count times the ports of the module's IO
+        template<typename... ios_t, std::size_t lane_count>
+        struct lanes_manifest<Manifest<ios_t...>, lane_count> {
+            using type = Manifest<
+                IO<
+                typename io_traits<ios_t>::type,
+                io_traits<ios_t>::input_count * lane_count,
+                io_traits<ios_t>::output_count * lane_count,
+                io_traits<ios_t>::strict_connection
+                >...
+            >;
+        };
+
+        template<typename module_t, std::size_t lane_count, typename = void>
+        struct has_lane_batch : std::false_type {};
+
+        template<typename module_t, std::size_t lane_count>
+        struct has_lane_batch<module_t, lane_count, std::void_t<typename module_t::template batch<lane_count>>> : std::true_type {};
+
+        template<typename module_t, std::size_t lane_count, bool = has_lane_batch<module_t, lane_count>::value>
+        struct lane_batch {
+            using type = void;
+        };
+
+        template<typename module_t, std::size_t lane_count>
+        struct lane_batch<module_t, lane_count, true> {
+            using type = typename module_t::template batch<lane_count>;
+        };
+
+    } // namespace detail
+
+    // Context handed to a lane batch: the ports of lane `l` are the ports of the wrapped node
+    // starting at l * (port count of the module), in module port order.
+    template<typename context_t, typename manifest_t, std::size_t lane_count>
+    struct LaneContext {
+
+        constexpr explicit LaneContext(context_t& ctx) : mCtx(ctx) {}
+
+        static constexpr std::size_t lanes() { return lane_count; }
+
+        template<typename data_t>
+        static constexpr std::size_t input_count() {
+            return manifest_t::template input_count<data_t>();
+        }
+
+        template<typename data_t>
+        static constexpr std::size_t output_count() {
+            return manifest_t::template output_count<data_t>();
+        }
+
+        template<typename data_t>
+        constexpr inline const data_t& input(std::size_t lane, std::size_t port = 0) const {
+            return mCtx.template input<data_t>(lane * input_count<data_t>() + port);
+        }
+
+        template<typename data_t>
+        constexpr inline data_t& output(std::size_t lane, std::size_t port = 0) {
+            return mCtx.template output<data_t>(lane * output_count<data_t>() + port);
+        }
+
+        template<typename... args_t>
+        bool log(const char* format, const args_t&... args) const {
+            return mCtx.log(format, args...);
+        }
+
+    private:
+        context_t& mCtx;
+    };
+
+    // Node module running `lane_count` instances of `module_t`, e.g. the voices of a synth.
+    //
+    // When module_t declares a lane batch,
+    //   template<std::size_t lane_count> struct batch { template<typename lane_context_t> void process(lane_context_t&); };
+    // the lanes are stored as one batch, which keeps their state structure-of-arrays so a single
+    // loop over the lanes can be vectorized. Otherwise the lanes are plain module_t instances
+    // processed one after the other with their own Context.
+    //
+    // Port p of type T of lane l is port l * N + p of the Lanes node, where N is the module's
+    // port count for T (see input_port / output_port).
+    template<typename module_t, std::size_t lane_count>
+    class Lanes {
+
+        static_assert(lane_count > 0, "Lanes needs at least one lane");
+
+        using module_manifest_t = typename module_t::Manifest;
+
+    public:
+
+        using Manifest = typename detail::lanes_manifest<module_manifest_t, lane_count>::type;
+
+        static constexpr bool is_batched = detail::has_lane_batch<module_t, lane_count>::value;
+
+        using batch_type = typename detail::lane_batch<module_t, lane_count>::type;
+
+        static constexpr std::size_t size() { return lane_count; }
+
+        template<typename data_t, std::size_t lane, std::size_t port = 0>
+        static constexpr std::size_t input_port() {
+            static_assert(lane < lane_count, "Invalid lane");
+            static_assert(port < module_manifest_t::template input_count<data_t>(), "Invalid input index for this type");
+            return lane * module_manifest_t::template input_count<data_t>() + port;
+        }
+
+        template<typename data_t, std::size_t lane, std::size_t port = 0>
+        static constexpr std::size_t output_port() {
+            static_assert(lane < lane_count, "Invalid lane");
+            static_assert(port < module_manifest_t::template output_count<data_t>(), "Invalid output index for this type");
+            return lane * module_manifest_t::template output_count<data_t>() + port;
+        }
+
+        // Lane storage: the batch, or the array of scalar instances
+        constexpr auto& lanes() { return mLanes; }
+        constexpr const auto& lanes() const { return mLanes; }
+
+        template<typename context_t>
+        void process(context_t& ctx) {
+            if constexpr (is_batched) {
+                LaneContext<context_t, module_manifest_t, lane_count> lctx(ctx);
+                mLanes.process(lctx);
+            }
+            else {
+                process_lanes(ctx, std::make_index_sequence<lane_count>{});
+            }
+        }
+
+    private:
+
+        template<typename context_t, std::size_t... L>
+        void process_lanes(context_t& ctx, std::index_sequence<L...>) {
+            (process_lane<L>(ctx), ...);
+        }
+
+        template<std::size_t lane, typename context_t>
+        void process_lane(context_t& ctx) {
+            auto& lctx = mContexts[lane];
+            bind_lane<lane>(ctx, lctx, std::make_index_sequence<module_manifest_t::type_count>{});
+            mLanes[lane].process(lctx);
+        }
+
+        template<std::size_t lane, typename context_t, std::size_t... T>
+        static void bind_lane(context_t& ctx, Context<module_manifest_t>& lctx, std::index_sequence<T...>) {
+            (bind_type<lane, typename module_manifest_t::template type_at<T>>(
+                ctx,
+                lctx,
+                std::make_index_sequence<module_manifest_t::template input_count<typename module_manifest_t::template type_at<T>>()>{},
+                std::make_index_sequence<module_manifest_t::template output_count<typename module_manifest_t::template type_at<T>>()>{}
+            ), ...);
+        }
+
+        // Point the lane context at the ports of its lane, unconnected ports stay null
+        template<std::size_t lane, typename data_t, typename context_t, std::size_t... in, std::size_t... out>
+        static void bind_type(context_t& ctx, Context<module_manifest_t>& lctx, std::index_sequence<in...>, std::index_sequence<out...>) {
+            (lctx.template set_input_ptr<in, data_t>(
+                ctx.template has_input<data_t, input_port<data_t, lane, in>()>()
+                ? const_cast<data_t*>(&ctx.template input<data_t>(input_port<data_t, lane, in>()))
+                : nullptr
+            ), ...);
+            (lctx.template set_output_ptr<out, data_t>(
+                ctx.template has_output<data_t, output_port<data_t, lane, out>()>()
+                ? &ctx.template output<data_t>(output_port<data_t, lane, out>())
+                : nullptr
+            ), ...);
+        }
+
+        using lanes_storage_t = std::conditional_t<is_batched, batch_type, std::array<module_t, lane_count>>;
+
+        struct no_contexts {};
+        using contexts_t = std::conditional_t<is_batched, no_contexts, std::array<Context<module_manifest_t>, lane_count>>;
+
+        alignas(cache_line_size) lanes_storage_t mLanes {};
+        contexts_t mContexts {};
+    };
+
+} // namespace ugraph
@@ -0,0 +1,281 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "storage.hpp"
+
+namespace ugraph {
+
+    // One message: a format string with "{}" placeholders and up to max_args encoded arguments.
+    // Strings (format and text arguments) are stored as pointers and must outlive the drain,
+    // i.e. string literals or other static storage.
+    struct LogRecord {
+
+        static constexpr std::size_t max_args = 6;
+        static constexpr std::uint32_t no_node = ~std::uint32_t(0);
+
+        enum class Type : std::uint8_t { i64, u64, f64, boolean, text, pointer };
+
+        union Value {
+            std::int64_t i;
+            std::uint64_t u;
+            double d;
+            const char* s;
+            const void* p;
+        };
+
+        const char* format = nullptr;
+        std::uint64_t time = 0;                 // steady clock, nanoseconds
+        std::uint32_t node = no_node;           // topological position when logged through Logger
+        std::uint8_t count = 0;
+        std::array<Type, max_args> types {};
+        std::array<Value, max_args> values {};
+    };
+
+    namespace detail {
+
+        // Logger the calling thread writes to, see Logger::attach()
+        struct log_binding {
+            bool (*push)(void*, const LogRecord&) = nullptr;
+            void* logger = nullptr;
+            std::uint32_t node = LogRecord::no_node;
+        };
+
+        inline log_binding& thread_log_binding() {
+            static thread_local log_binding binding;
+            return binding;
+        }
+
+        template<typename T>
+        void encode_log_arg(LogRecord& r, std::size_t i, const T& v) {
+            using value_t = std::decay_t<T>;
+            auto& type = r.types[i];
+            auto& value = r.values[i];
+            if constexpr (std::is_same_v<value_t, bool>) {
+                type = LogRecord::Type::boolean;
+                value.u = v;
+            }
+            else if constexpr (std::is_enum_v<value_t>) {
+                encode_log_arg(r, i, static_cast<std::underlying_type_t<value_t>>(v));
+            }
+            else if constexpr (std::is_integral_v<value_t> && std::is_signed_v<value_t>) {
+                type = LogRecord::Type::i64;
+                value.i = v;
+            }
+            else if constexpr (std::is_integral_v<value_t>) {
+                type = LogRecord::Type::u64;
+                value.u = v;
+            }
+            else if constexpr (std::is_floating_point_v<value_t>) {
+                type = LogRecord::Type::f64;
+                value.d = static_cast<double>(v);
+            }
+            else if constexpr (std::is_same_v<value_t, const char*> || std::is_same_v<value_t, char*>) {
+                type = LogRecord::Type::text;
+                value.s = v;
+            }
+            else if constexpr (std::is_pointer_v<value_t>) {
+                type = LogRecord::Type::pointer;
+                value.p = static_cast<const void*>(v);
+            }
+            else {
+                static_assert(std::is_arithmetic_v<value_t>, "Log arguments are numbers, enums, bools, static strings or pointers");
+            }
+        }
+
+        template<typename stream_t>
+        void write_log_arg(stream_t& out, LogRecord::Type type, const LogRecord::Value& value) {
+            switch (type) {
+                case LogRecord::Type::i64: out << value.i; break;
+                case LogRecord::Type::u64: out << value.u; break;
+                case LogRecord::Type::f64: out << value.d; break;
+                case LogRecord::Type::boolean: out << (value.u ? "true" : "false"); break;
+                case LogRecord::Type::text: out << (value.s ? value.s : "(null)"); break;
+                case LogRecord::Type::pointer: out << value.p; break;
+            }
+        }
+
+    } // namespace detail
+
+    // Logs to the logger attached to the calling thread; never blocks nor allocates. Returns false
+    // when no logger is attached or the record was dropped because its ring was full.
+    template<typename... args_t>
+    bool log(const char* format, const args_t&... args) {
+        static_assert(sizeof...(args_t) <= LogRecord::max_args, "Too many log arguments");
+        const auto& binding = detail::thread_log_binding();
+        if (binding.push == nullptr) {
+            return false;
+        }
+        LogRecord r;
+        r.format = format;
+        r.time = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        r.node = binding.node;
+        r.count = static_cast<std::uint8_t>(sizeof...(args_t));
+        std::size_t i = 0;
+        (detail::encode_log_arg(r, i++, args), ...);
+        return binding.push(binding.logger, r);
+    }
+
+    // Writes "<time ns> [node <position>] <message>\n", placeholders replaced by the arguments
+    template<typename stream_t>
+    void write_log_record(stream_t& out, const LogRecord& r) {
+        out << r.time << " ";
+        if (r.node != LogRecord::no_node) {
+            out << "[node " << r.node << "] ";
+        }
+        std::size_t arg = 0;
+        for (const char* c = r.format ? r.format : ""; *c != '\0'; ++c) {
+            if (c[0] == '{' && c[1] == '}' && arg < r.count) {
+                detail::write_log_arg(out, r.types[arg], r.values[arg]);
+                ++arg;
+                ++c;
+            }
+            else {
+                out << *c;
+            }
+        }
+        out << "\n";
+    }
+
+    // Preallocated multi producer / single consumer ring of log records (bounded queue with a
+    // sequence number per cell): any thread attached to the logger pushes with a CAS on the head,
+    // a single thread drains. Records pushed while the ring is full are dropped and counted.
+    // Used as a for_each policy it also tags the records with the node topological position.
+    template<std::size_t capacity = 1024>
+    class Logger {
+
+        static_assert(capacity > 1 && (capacity & (capacity - 1)) == 0, "Log ring capacity must be a power of two");
+
+        struct cell {
+            std::atomic<std::uint64_t> sequence;
+            LogRecord record;
+        };
+
+        std::array<cell, capacity> mCells;
+        alignas(cache_line_size) std::atomic<std::uint64_t> mHead { 0 };
+        std::atomic<std::uint64_t> mDropped { 0 };
+        alignas(cache_line_size) std::uint64_t mTail = 0;     // consumer only
+
+        static bool push_to(void* logger, const LogRecord& r) { return static_cast<Logger*>(logger)->push(r); }
+
+    public:
+
+        // Restores the previous binding of the thread when destroyed
+        class Attachment {
+            detail::log_binding mPrevious;
+        public:
+            explicit Attachment(Logger& logger) : mPrevious(detail::thread_log_binding()) {
+                detail::thread_log_binding() = { &Logger::push_to, &logger, LogRecord::no_node };
+            }
+            ~Attachment() { detail::thread_log_binding() = mPrevious; }
+            Attachment(const Attachment&) = delete;
+            Attachment& operator=(const Attachment&) = delete;
+        };
+
+        Logger() {
+            for (std::size_t i = 0; i < capacity; ++i) {
+                mCells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        static constexpr std::size_t size() { return capacity; }
+
+        // ugraph::log() and ctx.log() of the calling thread go to this logger while the result lives
+        [[nodiscard]] Attachment attach() { return Attachment(*this); }
+
+        template<std::size_t node_index, typename F>
+        void invoke(F&& f) {
+            Attachment attachment(*this);
+            detail::thread_log_binding().node = static_cast<std::uint32_t>(node_index);
+            f();
+        }
+
+        bool push(const LogRecord& r) {
+            std::uint64_t pos = mHead.load(std::memory_order_relaxed);
+            cell* c;
+            for (;;) {
+                c = &mCells[pos & (capacity - 1)];
+                const std::uint64_t seq = c->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::int64_t>(seq - pos);
+                if (diff == 0) {
+                    if (mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    mDropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else {
+                    pos = mHead.load(std::memory_order_relaxed);
+                }
+            }
+            c->record = r;
+            c->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side, one thread at a time
+        bool pop(LogRecord& r) {
+            cell& c = mCells[mTail & (capacity - 1)];
+            if (c.sequence.load(std::memory_order_acquire) != mTail + 1) {
+                return false;
+            }
+            r = c.record;
+            c.sequence.store(mTail + capacity, std::memory_order_release);
+            ++mTail;
+            return true;
+        }
+
+        // Writes every pending record, returns how many
+        template<typename stream_t>
+        std::size_t drain(stream_t& out) {
+            std::size_t n = 0;
+            LogRecord r;
+            while (pop(r)) {
+                write_log_record(out, r);
+                ++n;
+            }
+            return n;
+        }
+
+        std::uint64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+    };
+
+} // namespace ugraph
@@ -0,0 +1,82 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+#include "log.hpp"
+
+namespace ugraph {
+
+    // Background thread draining a Logger into a stream (formatting happens here, off the audio
+    // thread). Pending records are written once more when the drain is destroyed.
+    template<typename logger_t, typename stream_t>
+    class LogDrain {
+
+        logger_t& mLogger;
+        stream_t& mOut;
+        std::atomic<bool> mRunning { true };
+        std::atomic<std::size_t> mWritten { 0 };
+        std::thread mThread;
+
+    public:
+
+        LogDrain(logger_t& logger, stream_t& out, std::chrono::milliseconds period = std::chrono::milliseconds(10)) :
+            mLogger(logger), mOut(out), mThread([this, period] {
+                while (mRunning.load(std::memory_order_acquire)) {
+                    poll();
+                    std::this_thread::sleep_for(period);
+                }
+                poll();
+            }) {}
+
+        ~LogDrain() {
+            mRunning.store(false, std::memory_order_release);
+            mThread.join();
+        }
+
+        LogDrain(const LogDrain&) = delete;
+        LogDrain& operator=(const LogDrain&) = delete;
+
+        std::size_t written() const { return mWritten.load(std::memory_order_acquire); }
+
+    private:
+
+        void poll() {
+            const std::size_t n = mLogger.drain(mOut);
+            if (n != 0) {
+                mOut.flush();
+                mWritten.fetch_add(n, std::memory_order_release);
+            }
+        }
+    };
+
+} // namespace ugraph
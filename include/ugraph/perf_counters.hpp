@@ -0,0 +1,294 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "storage.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ugraph {
+
+    // Hardware events counted by PerfCounters, in the order of their values
+    enum class PerfEvent : std::size_t { cycles, instructions, l1d_misses, llc_misses, branch_misses, count };
+
+    inline constexpr std::size_t perf_event_count = static_cast<std::size_t>(PerfEvent::count);
+
+    // Raw running totals of a counter group, with the time it was enabled and actually counting.
+    // The two differ when the kernel multiplexes more groups than the PMU has counters.
+    struct PerfReading {
+        std::array<std::uint64_t, perf_event_count> values {};
+        std::uint64_t time_enabled = 0;
+        std::uint64_t time_running = 0;
+    };
+
+    // Counts between two readings, extrapolated to the enabled time when the group was multiplexed
+    struct PerfDelta {
+        std::array<std::uint64_t, perf_event_count> values {};
+        bool running = false;       // false: the group never counted in between, values are zeros
+        bool scaled = false;
+    };
+
+    // Group of hardware counters of the calling thread (Linux perf_event_open, user space only).
+    // Events the kernel or the machine refuses are left out; when none opens, as with a restrictive
+    // perf_event_paranoid or inside most containers, available() is false and read() returns zeros.
+    class PerfCounters {
+
+        std::array<int, perf_event_count> mFds;
+        std::array<std::size_t, perf_event_count> mSlot {};  // position of each event in a group read
+        std::size_t mOpened = 0;
+        int mLeader = -1;
+
+#if defined(__linux__)
+        static int open_event(std::uint32_t type, std::uint64_t config, int group) {
+            perf_event_attr attr {};
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = group == -1 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+
+        static constexpr std::uint64_t cache_miss(std::uint64_t cache) {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+#endif
+
+    public:
+
+        PerfCounters() {
+            mFds.fill(-1);
+#if defined(__linux__)
+            constexpr std::uint32_t types[perf_event_count] = {
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+            };
+            constexpr std::uint64_t configs[perf_event_count] = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                cache_miss(PERF_COUNT_HW_CACHE_L1D), cache_miss(PERF_COUNT_HW_CACHE_LL),
+                PERF_COUNT_HW_BRANCH_MISSES
+            };
+            for (std::size_t e = 0; e < perf_event_count; ++e) {
+                const int fd = open_event(types[e], configs[e], mLeader);
+                if (fd < 0) {
+                    continue;
+                }
+                if (mLeader < 0) {
+                    mLeader = fd;
+                }
+                mFds[e] = fd;
+                mSlot[e] = mOpened++;
+            }
+            if (mLeader >= 0) {
+                ioctl(mLeader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(mLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        ~PerfCounters() {
+#if defined(__linux__)
+            for (const int fd : mFds) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool available() const { return mLeader >= 0; }
+        bool available(PerfEvent e) const { return mFds[static_cast<std::size_t>(e)] >= 0; }
+
+        // Raw running totals of every event, zero for the events that are not available
+        PerfReading sample() const {
+            PerfReading r;
+#if defined(__linux__)
+            if (mLeader < 0) {
+                return r;
+            }
+            // nr, time enabled, time running, then one value per opened event
+            std::uint64_t buffer[3 + perf_event_count] {};
+            if (::read(mLeader, buffer, sizeof(buffer)) <= 0) {
+                return r;
+            }
+            r.time_enabled = buffer[1];
+            r.time_running = buffer[2];
+            for (std::size_t e = 0; e < perf_event_count; ++e) {
+                if (mFds[e] >= 0) {
+                    r.values[e] = buffer[3 + mSlot[e]];
+                }
+            }
+#endif
+            return r;
+        }
+
+        static PerfDelta delta(const PerfReading& before, const PerfReading& after) {
+            PerfDelta d;
+            const std::uint64_t enabled = after.time_enabled - before.time_enabled;
+            const std::uint64_t running = after.time_running - before.time_running;
+            if (running == 0) {
+                return d;
+            }
+            d.running = true;
+            d.scaled = running < enabled;
+            for (std::size_t e = 0; e < perf_event_count; ++e) {
+                const std::uint64_t v = after.values[e] - before.values[e];
+                d.values[e] = d.scaled
+                    ? static_cast<std::uint64_t>(static_cast<double>(v) * static_cast<double>(enabled) / static_cast<double>(running) + 0.5)
+                    : v;
+            }
+            return d;
+        }
+
+        // Totals since the counters were opened, extrapolated when the group was multiplexed
+        std::array<std::uint64_t, perf_event_count> read() const {
+            return delta(PerfReading {}, sample()).values;
+        }
+    };
+
+    // Per-node totals of a PerfProfiler
+    struct PerfNodeStats {
+        std::uint64_t calls = 0;
+        std::uint64_t scaled = 0;       // calls whose counts were extrapolated (multiplexed group)
+        std::uint64_t unscheduled = 0;  // calls during which the group never counted, left out of events
+        std::array<std::uint64_t, perf_event_count> events {};
+
+        std::uint64_t operator[](PerfEvent e) const { return events[static_cast<std::size_t>(e)]; }
+
+        double per_call(PerfEvent e) const {
+            const std::uint64_t counted = calls - unscheduled;
+            return counted ? static_cast<double>((*this)[e]) / static_cast<double>(counted) : 0.0;
+        }
+
+        // Instructions per cycle
+        double ipc() const {
+            const auto cycles = (*this)[PerfEvent::cycles];
+            return cycles ? static_cast<double>((*this)[PerfEvent::instructions]) / static_cast<double>(cycles) : 0.0;
+        }
+    };
+
+    // Hardware counters per node, summed over the worker threads running the graph. Every worker
+    // gets its own policy with worker(index), created on that thread as counters follow the thread
+    // that opened them; stats() may be called from any thread. Costs two read() system calls per
+    // node call, so keep it for analysis builds.
+    template<std::size_t node_count, std::size_t worker_count = 1>
+    class PerfProfiler {
+
+        struct alignas(cache_line_size) entry {
+            std::atomic<std::uint64_t> calls { 0 };
+            std::atomic<std::uint64_t> scaled { 0 };
+            std::atomic<std::uint64_t> unscheduled { 0 };
+            std::array<std::atomic<std::uint64_t>, perf_event_count> events {};
+        };
+
+        std::array<std::array<entry, node_count>, worker_count> mEntries {};
+
+        // Single writer per entry
+        static void bump(std::atomic<std::uint64_t>& v, std::uint64_t by) {
+            v.store(v.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+    public:
+
+        class Worker {
+            PerfProfiler* mProfiler;
+            std::size_t mIndex;
+            PerfCounters mCounters;
+        public:
+            Worker(PerfProfiler& profiler, std::size_t index) : mProfiler(&profiler), mIndex(index) {}
+
+            bool available() const { return mCounters.available(); }
+            const PerfCounters& counters() const { return mCounters; }
+
+            template<std::size_t node_index, typename F>
+            void invoke(F&& f) {
+                static_assert(node_index < node_count, "Profiler is smaller than the graph");
+                if (!mCounters.available()) {
+                    f();
+                    mProfiler->record(mIndex, node_index, {});
+                    return;
+                }
+                const auto before = mCounters.sample();
+                f();
+                const auto after = mCounters.sample();
+                const auto delta = PerfCounters::delta(before, after);
+                mProfiler->record(mIndex, node_index, delta.values, delta.running, delta.scaled);
+            }
+        };
+
+        static constexpr std::size_t size() { return node_count; }
+
+        // Opens the counters of the calling thread, which must be the one running the graph
+        Worker worker(std::size_t index) { return Worker(*this, index); }
+
+        void record(std::size_t worker_index, std::size_t node_index, const std::array<std::uint64_t, perf_event_count>& delta,
+                    bool running = true, bool scaled = false) {
+            entry& e = mEntries[worker_index][node_index];
+            bump(e.calls, 1);
+            if (!running) {
+                bump(e.unscheduled, 1);
+                return;
+            }
+            if (scaled) {
+                bump(e.scaled, 1);
+            }
+            for (std::size_t i = 0; i < perf_event_count; ++i) {
+                bump(e.events[i], delta[i]);
+            }
+        }
+
+        PerfNodeStats stats(std::size_t node_index) const {
+            PerfNodeStats s;
+            for (const auto& worker : mEntries) {
+                const entry& e = worker[node_index];
+                s.calls += e.calls.load(std::memory_order_relaxed);
+                s.scaled += e.scaled.load(std::memory_order_relaxed);
+                s.unscheduled += e.unscheduled.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < perf_event_count; ++i) {
+                    s.events[i] += e.events[i].load(std::memory_order_relaxed);
+                }
+            }
+            return s;
+        }
+    };
+
+} // namespace ugraph
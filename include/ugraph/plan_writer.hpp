@@ -0,0 +1,261 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+#include <utility>
+#include <string_view>
+#include <initializer_list>
+
+#include "static_graph.hpp"
+#include "type_traits/type_list.hpp"
+#include "type_traits/graph_traits.hpp"
+
+namespace ugraph {
+
+    namespace detail {
+
+        // Edges of a Graph, OwningGraph or StaticGraph type
+        template<typename graph_t>
+        struct plan_source;
+
+        template<template<typename...> class graph_tpl, typename... edges_t>
+        struct plan_source<graph_tpl<edges_t...>> {
+            using traits = data_graph_traits<edges_t...>;
+        };
+
+        // Fully qualified spelling of T, as the compiler prints it
+        template<typename T>
+        std::string_view spelled_type_name() {
+#if defined(__clang__) || defined(__GNUC__)
+            const std::string_view p = __PRETTY_FUNCTION__;
+            const auto start = p.find("T = ");
+            if (start == p.npos) {
+                return {};
+            }
+            std::string_view s = p.substr(start + 4);
+            const auto end = s.find(';');
+            return s.substr(0, end != s.npos ? end : s.rfind(']'));
+#elif defined(_MSC_VER)
+            const std::string_view p = __FUNCSIG__;
+            constexpr std::string_view key = "spelled_type_name<";
+            const auto start = p.find(key);
+            if (start == p.npos) {
+                return {};
+            }
+            std::string_view s = p.substr(start + key.size());
+            return s.substr(0, s.rfind(">(void)"));
+#else
+            return {};
+#endif
+        }
+
+        // Names of anonymous-namespace types, local types and lambdas cannot be written in a header
+        constexpr bool spellable(std::string_view name) {
+            return !name.empty()
+                && name.find("anonymous") == name.npos
+                && name.find("lambda") == name.npos
+                && name.find("<unnamed") == name.npos
+                && name.find("()::") == name.npos;
+        }
+
+        // MSVC prefixes class names with their class-key
+        template<typename stream_t>
+        void write_type_name(stream_t& out, std::string_view name) {
+            constexpr std::string_view keys[] = { "struct ", "class ", "enum " };
+            while (!name.empty()) {
+                bool skipped = false;
+                for (auto k : keys) {
+                    if (name.substr(0, k.size()) == k) {
+                        name = name.substr(k.size());
+                        skipped = true;
+                    }
+                }
+                if (!skipped) {
+                    out << name.front();
+                    name = name.substr(1);
+                }
+            }
+        }
+
+        template<typename traits>
+        struct plan_writer {
+
+            using topology_t = typename traits::topology_t;
+            using manifest_t = typename traits::manifest_t;
+            using slots_t = static_slots<traits>;
+
+            static constexpr std::size_t node_count = topology_t::size();
+            static constexpr std::size_t type_count = manifest_t::type_count;
+
+            template<std::size_t I>
+            using module_at = typename traits::template node_type_at<I>::module_type;
+
+            template<std::size_t... I>
+            static bool modules_spellable(std::index_sequence<I...>) {
+                return (spellable(spelled_type_name<module_at<I>>()) && ... && true);
+            }
+
+            template<std::size_t... D>
+            static bool types_spellable(std::index_sequence<D...>) {
+                return (spellable(spelled_type_name<typename manifest_t::template type_at<D>>()) && ... && true);
+            }
+
+            template<typename stream_t, std::size_t... I>
+            static void write_modules(stream_t& out, std::index_sequence<I...>) {
+                ((out << (I == 0 ? "\n        " : ",\n        "), write_type_name(out, spelled_type_name<module_at<I>>())), ...);
+                out << "\n    ";
+            }
+
+            // The graph manifest may list a data type once per distinct IO spec; plans keep one entry
+            template<std::size_t D>
+            static constexpr bool first_of_type = manifest_t::template index<typename manifest_t::template type_at<D>>() == D;
+
+            template<std::size_t... D>
+            static constexpr std::size_t count_types(std::index_sequence<D...>) {
+                return ((first_of_type<D> ? 1 : 0) + ... + 0);
+            }
+
+            static constexpr std::size_t plan_type_count = count_types(std::make_index_sequence<type_count>{});
+
+            template<typename stream_t, std::size_t D>
+            static void write_data_type_of(stream_t& out, bool& first) {
+                if constexpr (first_of_type<D>) {
+                    out << (first ? "" : ", ");
+                    write_type_name(out, spelled_type_name<typename manifest_t::template type_at<D>>());
+                    first = false;
+                }
+            }
+
+            template<typename stream_t, std::size_t... D>
+            static void write_data_types(stream_t& out, std::index_sequence<D...>) {
+                bool first = true;
+                (write_data_type_of<stream_t, D>(out, first), ...);
+            }
+
+            template<typename stream_t, std::size_t D>
+            static void write_count_of(stream_t& out, bool& first) {
+                if constexpr (first_of_type<D>) {
+                    out << (first ? " " : ", ") << slots_t::template table<typename manifest_t::template type_at<D>>.count;
+                    first = false;
+                }
+            }
+
+            template<typename stream_t, std::size_t D>
+            static void write_offsets_of(stream_t& out, std::size_t& base, bool& first) {
+                if constexpr (first_of_type<D>) {
+                    using T = typename manifest_t::template type_at<D>;
+                    for (std::size_t i = 0; i <= node_count; ++i) {
+                        out << (first ? " " : ", ") << base + slots_t::template offsets<T>[i];
+                        first = false;
+                    }
+                    base += slots_t::template offsets<T>[node_count];
+                }
+            }
+
+            template<typename stream_t, std::size_t D>
+            static void write_slots_of(stream_t& out, std::size_t& ports) {
+                if constexpr (first_of_type<D>) {
+                    using T = typename manifest_t::template type_at<D>;
+                    for (std::size_t k = 0; k < slots_t::template offsets<T>[node_count]; ++k) {
+                        out << (ports == 0 ? " " : ", ") << slots_t::template table<T>.slots[k];
+                        ++ports;
+                    }
+                }
+            }
+
+            template<typename stream_t, std::size_t... D>
+            static void write_tables(stream_t& out, std::index_sequence<D...>) {
+                bool first = true;
+                out << "    static constexpr std::array<std::size_t, " << plan_type_count << "> slot_counts {";
+                (write_count_of<stream_t, D>(out, first), ...);
+                out << (first ? "};\n\n" : " };\n\n");
+
+                out << "    // Port -> slot tables, one per data type, node-major with inputs before outputs.\n"
+                    << "    // The ports of node I for data type D start at offsets[D * (size + 1) + I].\n";
+                out << "    static constexpr std::array<std::size_t, " << plan_type_count * (node_count + 1) << "> offsets {";
+                std::size_t base = 0;
+                first = true;
+                (write_offsets_of<stream_t, D>(out, base, first), ...);
+                out << (first ? "};\n" : " };\n");
+
+                std::ostringstream slots;
+                std::size_t ports = 0;
+                (write_slots_of<std::ostringstream, D>(slots, ports), ...);
+                out << "    static constexpr std::array<std::size_t, " << ports << "> slots {" << slots.str() << (ports == 0 ? "};\n" : " };\n");
+            }
+
+            template<typename stream_t>
+            static bool write(stream_t& out, std::string_view name, std::initializer_list<std::string_view> includes) {
+                if (!modules_spellable(std::make_index_sequence<node_count>{}) || !types_spellable(std::make_index_sequence<type_count>{})) {
+                    out << "#error \"ugraph: plan " << name << " uses a module or data type that cannot be named from a header "
+                        << "(anonymous namespace, local class or lambda)\"\n";
+                    return false;
+                }
+
+                out << "// Generated by ugraph::write_plan, do not edit.\n\n#pragma once\n\n#include <array>\n#include <cstddef>\n\n"
+                    << "#include \"ugraph/planned_graph.hpp\"\n";
+                for (auto inc : includes) {
+                    out << "#include \"" << inc << "\"\n";
+                }
+
+                out << "\nstruct " << name << " {\n\n";
+                out << "    // Modules in topological order\n    using modules = ugraph::detail::type_list<";
+                write_modules(out, std::make_index_sequence<node_count>{});
+                out << ">;\n";
+                out << "    using data_types = ugraph::detail::type_list<";
+                write_data_types(out, std::make_index_sequence<type_count>{});
+                out << ">;\n\n";
+
+                out << "    static constexpr std::size_t size = " << node_count << ";\n";
+                out << "    static constexpr std::array<std::size_t, size> ids {";
+                constexpr auto ids = topology_t::ids();
+                for (std::size_t i = 0; i < node_count; ++i) {
+                    out << (i == 0 ? " " : ", ") << ids[i];
+                }
+                out << (node_count == 0 ? "};\n\n" : " };\n\n");
+
+                write_tables(out, std::make_index_sequence<type_count>{});
+                out << "};\n";
+                return true;
+            }
+        };
+
+    } // namespace detail
+
+    // Writes the resolved order and port -> slot tables of graph_t as a header declaring
+    // `struct <name>`, to be run by PlannedGraph<name>. `includes` are the headers declaring the
+    // module and data types. Returns false (and writes an #error) when a type cannot be named.
+    template<typename graph_t, typename stream_t>
+    bool write_plan(stream_t& out, std::string_view name, std::initializer_list<std::string_view> includes = {}) {
+        using traits = typename detail::plan_source<std::decay_t<graph_t>>::traits;
+        return detail::plan_writer<traits>::write(out, name, includes);
+    }
+
+} // namespace ugraph
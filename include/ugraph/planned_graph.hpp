@@ -0,0 +1,273 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "manifest.hpp"
+#include "storage.hpp"
+#include "static_graph.hpp"
+#include "type_traits/type_list.hpp"
+
+namespace ugraph {
+
+    namespace detail {
+
+        template<typename list_t>
+        struct data_manifest;
+
+        template<typename... data_t>
+        struct data_manifest<type_list<data_t...>> { using type = Manifest<IO<data_t, 0, 0>...>; };
+
+        // Port -> slot tables read from a generated plan, with the interface StaticContext expects
+        // from static_slots. The plan stores every table in one array: the ports of node I for the
+        // data type D start at plan_t::offsets[D * (plan_t::size + 1) + I].
+        template<typename plan_t>
+        struct planned_slots {
+
+            using manifest_t = typename data_manifest<typename plan_t::data_types>::type;
+
+            template<std::size_t I>
+            using node_manifest_t = typename type_list_at<I, typename plan_t::modules>::type::Manifest;
+
+            template<typename T>
+            static constexpr auto make_offsets() {
+                constexpr std::size_t base = manifest_t::template index<T>() * (plan_t::size + 1);
+                std::array<std::size_t, plan_t::size + 1> o {};
+                for (std::size_t i = 0; i <= plan_t::size; ++i) {
+                    o[i] = plan_t::offsets[base + i];
+                }
+                return o;
+            }
+
+            template<typename T>
+            static constexpr auto offsets = make_offsets<T>();
+
+            template<typename T>
+            struct table_t {
+                decltype(plan_t::slots) slots {};
+                std::size_t count = 0;
+            };
+
+            template<typename T>
+            static constexpr table_t<T> table { plan_t::slots, plan_t::slot_counts[manifest_t::template index<T>()] };
+
+            template<typename T>
+            static constexpr std::size_t input_slot(std::size_t node_index, std::size_t port) {
+                return plan_t::slots[offsets<T>[node_index] + port];
+            }
+
+            template<typename T, std::size_t I>
+            static constexpr std::size_t input_count() {
+                if constexpr (node_manifest_t<I>::template contains<T>) {
+                    return node_manifest_t<I>::template input_count<T>();
+                }
+                else {
+                    return 0;
+                }
+            }
+
+            template<typename T, std::size_t... I>
+            static constexpr auto make_input_counts(std::index_sequence<I...>) {
+                return std::array<std::size_t, sizeof...(I) + 1> { input_count<T, I>()..., 0 };
+            }
+
+            template<typename T>
+            static constexpr auto input_counts = make_input_counts<T>(std::make_index_sequence<plan_t::size>{});
+
+            template<typename T>
+            static constexpr std::size_t output_slot(std::size_t node_index, std::size_t port) {
+                return plan_t::slots[offsets<T>[node_index] + input_counts<T>[node_index] + port];
+            }
+
+            template<std::size_t... I>
+            static constexpr auto make_graph_data_t(std::index_sequence<I...>) ->
+                std::tuple<std::array<typename manifest_t::template type_at<I>, plan_t::slot_counts[I]>...>;
+
+            using graph_data_t = decltype(make_graph_data_t(std::make_index_sequence<manifest_t::type_count>{}));
+        };
+
+        template<typename list_t>
+        struct module_ptrs;
+
+        template<typename... modules_t>
+        struct module_ptrs<type_list<modules_t...>> { using type = std::tuple<modules_t*...>; };
+
+    } // namespace detail
+
+    // Statically bound graph running from a plan generated offline by write_plan (see
+    // ugraph_plan_gen in cmake/ugraph_plan_gen.cmake): order and port -> slot tables are plain
+    // constexpr arrays, so including it costs neither topological sorting nor coloring. Modules are
+    // passed in plan order, i.e. the topological order of the graph the plan was generated from.
+    template<typename plan_t>
+    class PlannedGraph : public detail::node_visitor<PlannedGraph<plan_t>> {
+
+        friend class detail::node_visitor<PlannedGraph>;
+
+        using slots_t = detail::planned_slots<plan_t>;
+        using manifest_t = typename slots_t::manifest_t;
+        using modules_tuple_t = typename detail::module_ptrs<typename plan_t::modules>::type;
+
+        template<std::size_t I>
+        using module_at = typename detail::type_list_at<I, typename plan_t::modules>::type;
+
+        template<std::size_t I>
+        using context_at = StaticContext<slots_t, I, typename module_at<I>::Manifest>;
+
+    public:
+
+        using plan_type = plan_t;
+        using Manifest = manifest_t;
+        using graph_data_t = typename slots_t::graph_data_t;
+
+    private:
+
+        template<std::size_t... I>
+        static constexpr auto make_storage_tuple_t(std::index_sequence<I...>) ->
+            std::tuple<detail::slot_storage<typename manifest_t::template type_at<I>, plan_t::slot_counts[I]>...>;
+
+        using storage_tuple_t = decltype(make_storage_tuple_t(std::make_index_sequence<manifest_t::type_count>{}));
+
+        modules_tuple_t mModules;
+        graph_data_t mData {};
+        storage_tuple_t mStorage;
+        std::size_t mMaxViewSize = 0;
+
+    public:
+
+        template<typename... modules_t>
+        constexpr explicit PlannedGraph(modules_t&... modules) : mModules(&modules...) {
+            static_assert(std::is_same_v<std::tuple<modules_t*...>, modules_tuple_t>, "Modules must match the plan, in plan order");
+        }
+
+        static constexpr std::size_t size() { return plan_t::size; }
+        static constexpr auto ids() { return plan_t::ids; }
+
+        // Position of a node id in plan order, size() when absent
+        static constexpr std::size_t position_of(std::size_t node_id) {
+            for (std::size_t i = 0; i < plan_t::size; ++i) {
+                if (plan_t::ids[i] == node_id) {
+                    return i;
+                }
+            }
+            return plan_t::size;
+        }
+
+        template<std::size_t node_id>
+        static constexpr bool contains_node_id() { return position_of(node_id) != plan_t::size; }
+
+        // Slots of each data type, including the dedicated slots of unconnected ports
+        template<typename data_t>
+        static constexpr std::size_t slot_count() {
+            return plan_t::slot_counts[manifest_t::template index<data_t>()];
+        }
+
+        constexpr graph_data_t& graph_data() { return mData; }
+        constexpr const graph_data_t& graph_data() const { return mData; }
+
+        template<typename data_t>
+        constexpr data_t& data_at(std::size_t i) {
+            return std::get<manifest_t::template index<data_t>()>(mData)[i];
+        }
+
+        template<std::size_t node_id, typename data_t>
+        constexpr data_t& input() {
+            static_assert(node_manifest_t<node_id>::template input_count<data_t>() == 1, "Only valid for single-input types; use input_at");
+            return input_at<node_id, 0, data_t>();
+        }
+
+        template<std::size_t node_id, std::size_t input_index, typename data_t>
+        constexpr data_t& input_at() {
+            static_assert(input_index < node_manifest_t<node_id>::template input_count<data_t>(), "Invalid input index for this node/type");
+            constexpr std::size_t slot = slots_t::template input_slot<data_t>(node_index_of<node_id>(), input_index);
+            return data_at<data_t>(slot);
+        }
+
+        template<std::size_t node_id, typename data_t>
+        constexpr data_t& output() {
+            static_assert(node_manifest_t<node_id>::template output_count<data_t>() == 1, "Only valid for single-output types; use output_at");
+            return output_at<node_id, 0, data_t>();
+        }
+
+        template<std::size_t node_id, std::size_t output_index, typename data_t>
+        constexpr data_t& output_at() {
+            static_assert(output_index < node_manifest_t<node_id>::template output_count<data_t>(), "Invalid output index for this node/type");
+            constexpr std::size_t slot = slots_t::template output_slot<data_t>(node_index_of<node_id>(), output_index);
+            return data_at<data_t>(slot);
+        }
+
+        // See StaticGraph::prepare
+        void prepare(std::size_t max_size) {
+            mMaxViewSize = max_size;
+            std::apply([&] (auto&... storages) { (storages.allocate(max_size), ...); }, mStorage);
+            resize_views(max_size);
+        }
+
+        template<typename arena_t>
+        bool prepare(std::size_t max_size, arena_t& arena) {
+            mMaxViewSize = max_size;
+            const bool ok = std::apply([&] (auto&... storages) { return (storages.allocate(max_size, arena) & ... & true); }, mStorage);
+            resize_views(max_size);
+            return ok;
+        }
+
+        void resize_views(std::size_t size) {
+            if (size > mMaxViewSize) {
+                size = mMaxViewSize;
+            }
+            resize_views_impl(size, std::make_index_sequence<manifest_t::type_count>{});
+        }
+
+    private:
+
+        template<std::size_t node_id>
+        static constexpr std::size_t node_index_of() {
+            static_assert(contains_node_id<node_id>(), "Invalid node id");
+            return position_of(node_id);
+        }
+
+        template<std::size_t node_id>
+        using node_manifest_t = typename module_at<node_index_of<node_id>()>::Manifest;
+
+        template<std::size_t I, typename F>
+        constexpr void for_each_at(F&& f) {
+            context_at<I> ctx(mData);
+            f(*std::get<I>(mModules), ctx);
+        }
+
+        template<std::size_t... I>
+        void resize_views_impl(std::size_t size, std::index_sequence<I...>) {
+            (std::get<I>(mStorage).wire(std::get<I>(mData), size), ...);
+        }
+    };
+
+} // namespace ugraph
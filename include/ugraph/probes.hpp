@@ -0,0 +1,124 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// USDT probes (provider "ugraph"), compiled in when UGRAPH_PROBES is defined. A probe is a single
+// nop plus an ELF note (.note.stapsdt) read by bpftrace, perf probe or systemtap, e.g.
+//   bpftrace -e 'usdt:./synth:ugraph:node_exit { @[arg0] = count(); }'
+// <sys/sdt.h> is used when available, otherwise the notes are emitted the same way here.
+#if defined(UGRAPH_PROBES) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define UGRAPH_PROBES_ENABLED 1
+#define UGRAPH_PROBE1(name, a0) DTRACE_PROBE1(ugraph, name, a0)
+#define UGRAPH_PROBE3(name, a0, a1, a2) DTRACE_PROBE3(ugraph, name, a0, a1, a2)
+#elif defined(UGRAPH_PROBES) && defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__))
+#define UGRAPH_PROBES_ENABLED 1
+// Arguments are 64 bit unsigned values held in registers ("8@%rdi" / "8@x0")
+#define UGRAPH_PROBE_ASM(name, args, ...)                                                          \
+    __asm__ __volatile__ (                                                                         \
+        "990: nop\n"                                                                               \
+        ".pushsection .note.stapsdt,\"\",\"note\"\n"                                               \
+        ".balign 4\n"                                                                              \
+        ".4byte 992f-991f, 994f-993f, 3\n"                                                         \
+        "991: .asciz \"stapsdt\"\n"                                                                \
+        "992: .balign 4\n"                                                                         \
+        "993: .8byte 990b\n"                                                                       \
+        ".8byte _.stapsdt.base\n"                                                                  \
+        ".8byte 0\n"                                                                               \
+        ".asciz \"ugraph\"\n"                                                                      \
+        ".asciz \"" #name "\"\n"                                                                   \
+        ".asciz \"" args "\"\n"                                                                    \
+        "994: .balign 4\n"                                                                         \
+        ".popsection\n"                                                                            \
+        ".ifndef _.stapsdt.base\n"                                                                 \
+        ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"                    \
+        ".weak _.stapsdt.base\n"                                                                   \
+        ".hidden _.stapsdt.base\n"                                                                 \
+        "_.stapsdt.base: .space 1\n"                                                               \
+        ".size _.stapsdt.base, 1\n"                                                                \
+        ".popsection\n"                                                                            \
+        ".endif\n"                                                                                 \
+        :: __VA_ARGS__)
+#define UGRAPH_PROBE1(name, a0)                                                                    \
+    UGRAPH_PROBE_ASM(name, "8@%[p0]", [p0] "r" (static_cast<std::uint64_t>(a0)))
+#define UGRAPH_PROBE3(name, a0, a1, a2)                                                            \
+    UGRAPH_PROBE_ASM(name, "8@%[p0] 8@%[p1] 8@%[p2]", [p0] "r" (static_cast<std::uint64_t>(a0)),   \
+                     [p1] "r" (static_cast<std::uint64_t>(a1)), [p2] "r" (static_cast<std::uint64_t>(a2)))
+#else
+#define UGRAPH_PROBES_ENABLED 0
+#define UGRAPH_PROBE1(name, a0) ((void)0)
+#define UGRAPH_PROBE3(name, a0, a1, a2) ((void)0)
+#endif
+
+namespace ugraph {
+
+    inline constexpr bool probes_enabled = UGRAPH_PROBES_ENABLED != 0;
+
+    // Execution policy firing the ugraph probes:
+    //   frame_start(frame), frame_end(frame)
+    //   node_enter(node id, topological index, frame), node_exit(node id, topological index, frame)
+    // Without UGRAPH_PROBES it only calls the nodes.
+    template<typename graph_t>
+    class Probes {
+
+        static constexpr auto ids = std::decay_t<graph_t>::ids();
+
+        std::uint64_t mFrame = 0;
+
+    public:
+
+        void begin_frame() { UGRAPH_PROBE1(frame_start, mFrame); }
+
+        template<std::size_t node_index, typename F>
+        void invoke(F&& f) {
+            UGRAPH_PROBE3(node_enter, ids[node_index], node_index, mFrame);
+            f();
+            UGRAPH_PROBE3(node_exit, ids[node_index], node_index, mFrame);
+        }
+
+        void end_frame() {
+            UGRAPH_PROBE1(frame_end, mFrame);
+            ++mFrame;
+        }
+
+        template<typename F>
+        void run(graph_t& graph, F&& f) {
+            begin_frame();
+            graph.for_each(*this, std::forward<F>(f));
+            end_frame();
+        }
+
+        std::uint64_t frame() const { return mFrame; }
+    };
+
+} // namespace ugraph
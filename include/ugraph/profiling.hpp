@@ -0,0 +1,214 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "storage.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace ugraph {
+
+    // Timestamp sources for NodeProfiler. A clock provides `static std::uint64_t now()`.
+    struct SteadyClock {
+        static std::uint64_t now() {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    };
+
+    // Time stamp counter (rdtsc on x86, the virtual counter on AArch64): a few cycles per read,
+    // in ticks of an invariant but platform specific frequency. Falls back to SteadyClock elsewhere.
+    struct CycleClock {
+        static std::uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+            return __rdtsc();
+#elif defined(__aarch64__)
+            std::uint64_t v;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+            return v;
+#else
+            return SteadyClock::now();
+#endif
+        }
+    };
+
+    // Execution policy of for_each(policy, f) running each node call as is.
+    struct NoProfiling {
+        template<std::size_t node_index, typename F>
+        static constexpr void invoke(F&& f) { f(); }
+    };
+
+    // Snapshot of the timings of one node, in clock ticks. histogram[b] counts the calls that took
+    // [2^(b-1), 2^b) ticks (b = 0: zero ticks); the last bucket also takes everything longer.
+    template<std::size_t bucket_count>
+    struct NodeTimings {
+        std::uint64_t count = 0;
+        std::uint64_t total = 0;
+        std::uint64_t min = 0;
+        std::uint64_t max = 0;
+        std::array<std::uint64_t, bucket_count> histogram {};
+
+        double mean() const { return count ? static_cast<double>(total) / static_cast<double>(count) : 0.0; }
+    };
+
+    // Execution policy of for_each(policy, f) timing every node call with clock_t. Timings live in
+    // a preallocated table indexed by topological position, one cache line aligned entry per node.
+    // One thread runs the graph (the only writer); any other thread may call timings() at any time:
+    // every entry is guarded by a sequence counter, so readers never block the writer and never
+    // see a half updated entry.
+    template<std::size_t node_count, typename clock_t = SteadyClock, std::size_t bucket_count = 32>
+    class NodeProfiler {
+
+        static_assert(bucket_count > 0, "At least one histogram bucket is needed");
+
+        struct alignas(cache_line_size) entry {
+            std::atomic<std::uint64_t> sequence { 0 };
+            std::atomic<std::uint64_t> count { 0 };
+            std::atomic<std::uint64_t> total { 0 };
+            std::atomic<std::uint64_t> min { ~std::uint64_t(0) };
+            std::atomic<std::uint64_t> max { 0 };
+            std::array<std::atomic<std::uint64_t>, bucket_count> histogram {};
+        };
+
+        std::array<entry, node_count> mEntries {};
+
+        static constexpr std::size_t bucket_of(std::uint64_t ticks) {
+            std::size_t b = 0;
+            while (ticks != 0 && b + 1 < bucket_count) {
+                ticks >>= 1;
+                ++b;
+            }
+            return b;
+        }
+
+        // Single writer: plain loads and stores, the sequence counter orders them for readers
+        static void bump(std::atomic<std::uint64_t>& v, std::uint64_t by) {
+            v.store(v.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+    public:
+
+        using clock_type = clock_t;
+
+        static constexpr std::size_t size() { return node_count; }
+        static constexpr std::size_t buckets() { return bucket_count; }
+
+        template<std::size_t node_index, typename F>
+        void invoke(F&& f) {
+            static_assert(node_index < node_count, "Profiler is smaller than the graph");
+            const std::uint64_t start = clock_t::now();
+            f();
+            record(node_index, clock_t::now() - start);
+        }
+
+        void record(std::size_t node_index, std::uint64_t ticks) {
+            entry& e = mEntries[node_index];
+            const std::uint64_t seq = e.sequence.load(std::memory_order_relaxed);
+            e.sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            bump(e.count, 1);
+            bump(e.total, ticks);
+            if (ticks < e.min.load(std::memory_order_relaxed)) {
+                e.min.store(ticks, std::memory_order_relaxed);
+            }
+            if (ticks > e.max.load(std::memory_order_relaxed)) {
+                e.max.store(ticks, std::memory_order_relaxed);
+            }
+            bump(e.histogram[bucket_of(ticks)], 1);
+
+            e.sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        // Consistent copy of the timings of one node, lock-free with respect to the writer
+        NodeTimings<bucket_count> timings(std::size_t node_index) const {
+            const entry& e = mEntries[node_index];
+            NodeTimings<bucket_count> t;
+            for (;;) {
+                const std::uint64_t before = e.sequence.load(std::memory_order_acquire);
+                if (before & 1) {
+                    continue;
+                }
+                t.count = e.count.load(std::memory_order_relaxed);
+                t.total = e.total.load(std::memory_order_relaxed);
+                t.min = e.min.load(std::memory_order_relaxed);
+                t.max = e.max.load(std::memory_order_relaxed);
+                for (std::size_t b = 0; b < bucket_count; ++b) {
+                    t.histogram[b] = e.histogram[b].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (e.sequence.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+            if (t.count == 0) {
+                t.min = 0;
+            }
+            return t;
+        }
+
+        // Total ticks of every node, e.g. the costs of print_profile
+        std::array<std::uint64_t, node_count> totals() const {
+            std::array<std::uint64_t, node_count> t {};
+            for (std::size_t i = 0; i < node_count; ++i) {
+                t[i] = timings(i).total;
+            }
+            return t;
+        }
+
+        // Clears every entry; call from the writer thread, between two runs
+        void reset() {
+            for (std::size_t i = 0; i < node_count; ++i) {
+                entry& e = mEntries[i];
+                const std::uint64_t seq = e.sequence.load(std::memory_order_relaxed);
+                e.sequence.store(seq + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                e.count.store(0, std::memory_order_relaxed);
+                e.total.store(0, std::memory_order_relaxed);
+                e.min.store(~std::uint64_t(0), std::memory_order_relaxed);
+                e.max.store(0, std::memory_order_relaxed);
+                for (auto& h : e.histogram) {
+                    h.store(0, std::memory_order_relaxed);
+                }
+                e.sequence.store(seq + 2, std::memory_order_release);
+            }
+        }
+    };
+
+} // namespace ugraph
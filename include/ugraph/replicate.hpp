@@ -0,0 +1,192 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "graph.hpp"
+#include "manifest.hpp"
+
+namespace ugraph {
+
+    namespace detail {
+
+        template<typename graph_t, std::size_t count, typename seq_t>
+        struct replicate_manifest;
+
+        // Every replica exposes the unconnected ports of the prototype graph. Whether they are left
+        // unconnected in the outer graph is up to the prototype's modules, so none is strict.
+        template<typename graph_t, std::size_t count, std::size_t... I>
+        struct replicate_manifest<graph_t, count, std::index_sequence<I...>> {
+            template<std::size_t J>
+            using type_at = typename graph_t::Manifest::template type_at<J>;
+
+            using type = Manifest<
+                IO<
+                type_at<I>,
+                graph_t::template unconnected_inputs<type_at<I>>().size() * count,
+                graph_t::template unconnected_outputs<type_at<I>>().size() * count,
+                false
+                >...
+            >;
+        };
+
+    } // namespace detail
+
+    // `count` instances of one graph type (Graph or OwningGraph), built by a factory called with
+    // the replica index. The ordering and slot coloring of graph_t are computed once, every replica
+    // gets its own graph data, and processing is a loop over the replicas.
+    //
+    // Replicate is also a node module: port k of type T of replica r is port r * K + k of the node,
+    // where K is the number of ports of type T left unconnected in graph_t (see input_port /
+    // output_port). Before a replica runs, these ports are bound to the matching graph ports.
+    template<typename graph_t, std::size_t count>
+    class Replicate {
+
+        static_assert(count > 0, "Replicate needs at least one replica");
+
+        using graph_manifest_t = typename graph_t::Manifest;
+        using graph_data_t = typename graph_t::graph_data_t;
+
+        template<typename data_t>
+        static constexpr auto inputs = graph_t::template unconnected_inputs<data_t>();
+
+        template<typename data_t>
+        static constexpr auto outputs = graph_t::template unconnected_outputs<data_t>();
+
+    public:
+
+        using Manifest = typename detail::replicate_manifest<graph_t, count, std::make_index_sequence<graph_manifest_t::type_count>>::type;
+
+        template<typename factory_t>
+        explicit Replicate(factory_t&& make) :
+            mGraphs(make_graphs(make, std::make_index_sequence<count>{})) {
+            init();
+        }
+
+        // Replicas point into their own graph data
+        Replicate(const Replicate&) = delete;
+        Replicate& operator=(const Replicate&) = delete;
+
+        static constexpr std::size_t size() { return count; }
+
+        template<typename data_t, std::size_t replica, std::size_t port = 0>
+        static constexpr std::size_t input_port() {
+            static_assert(replica < count, "Invalid replica");
+            static_assert(port < inputs<data_t>.size(), "Invalid input index for this type");
+            return replica * inputs<data_t>.size() + port;
+        }
+
+        template<typename data_t, std::size_t replica, std::size_t port = 0>
+        static constexpr std::size_t output_port() {
+            static_assert(replica < count, "Invalid replica");
+            static_assert(port < outputs<data_t>.size(), "Invalid output index for this type");
+            return replica * outputs<data_t>.size() + port;
+        }
+
+        graph_t& operator[](std::size_t replica) { return mGraphs[replica]; }
+        const graph_t& operator[](std::size_t replica) const { return mGraphs[replica]; }
+
+        graph_data_t& graph_data(std::size_t replica) { return mData[replica]; }
+
+        // See Graph::prepare, applied to every replica.
+        void prepare(std::size_t max_size) {
+            for (auto& g : mGraphs) {
+                g.prepare(max_size);
+            }
+            init();
+        }
+
+        void resize_views(std::size_t size) {
+            for (std::size_t r = 0; r < count; ++r) {
+                mGraphs[r].resize_views(mData[r], size);
+            }
+        }
+
+        // Visit every node of every replica, replica by replica
+        template<typename F>
+        void for_each(F&& f) {
+            for (auto& g : mGraphs) {
+                g.for_each(f);
+            }
+        }
+
+        template<typename context_t>
+        void process(context_t& ctx) {
+            for (std::size_t r = 0; r < count; ++r) {
+                bind(r, ctx, std::make_index_sequence<graph_manifest_t::type_count>{});
+                mGraphs[r].for_each([] (auto& m, auto& c) { m.process(c); });
+            }
+        }
+
+    private:
+
+        template<typename factory_t, std::size_t... R>
+        static std::array<graph_t, count> make_graphs(factory_t& make, std::index_sequence<R...>) {
+            return { { make(R)... } };
+        }
+
+        void init() {
+            for (std::size_t r = 0; r < count; ++r) {
+                mGraphs[r].init_graph_data(mData[r]);
+            }
+        }
+
+        template<typename context_t, std::size_t... T>
+        void bind(std::size_t replica, context_t& ctx, std::index_sequence<T...>) {
+            (bind_type<typename graph_manifest_t::template type_at<T>>(
+                replica,
+                ctx,
+                std::make_index_sequence<inputs<typename graph_manifest_t::template type_at<T>>.size()>{},
+                std::make_index_sequence<outputs<typename graph_manifest_t::template type_at<T>>.size()>{}
+            ), ...);
+        }
+
+        // Ports that are not bound in the outer graph keep whatever the replica had
+        template<typename data_t, typename context_t, std::size_t... in, std::size_t... out>
+        void bind_type(std::size_t replica, context_t& ctx, std::index_sequence<in...>, std::index_sequence<out...>) {
+            auto& g = mGraphs[replica];
+            ([&] {
+                if (auto* p = ctx.template input_ptr<data_t>(replica * sizeof...(in) + in)) {
+                    g.template bind_input_at<inputs<data_t>[in].node_id, inputs<data_t>[in].port, data_t>(const_cast<data_t&>(*p));
+                }
+                }(), ...);
+            ([&] {
+                if (auto* p = ctx.template output_ptr<data_t>(replica * sizeof...(out) + out)) {
+                    g.template bind_output_at<outputs<data_t>[out].node_id, outputs<data_t>[out].port, data_t>(*p);
+                }
+                }(), ...);
+        }
+
+        std::array<graph_t, count> mGraphs;
+        std::array<graph_data_t, count> mData {};
+    };
+
+} // namespace ugraph
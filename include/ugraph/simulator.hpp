@@ -0,0 +1,427 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "analysis.hpp"
+#include "profiling.hpp"
+
+namespace ugraph {
+
+    // How the simulated workers share the nodes of a frame.
+    //  serial:        one worker runs every node in topological order
+    //  levels:        a barrier after every topological level, the nodes of a level go to the first
+    //                 free worker
+    //  work_stealing: ready successors go to the local queue of the worker that released them, idle
+    //                 workers pop their own queue (newest first) then steal (oldest first)
+    //  static_lanes:  every node is pinned to a worker ahead of time, balanced on expected costs
+    enum class SchedulePolicy { serial, levels, work_stealing, static_lanes };
+
+    struct SimulationOptions {
+        SchedulePolicy policy = SchedulePolicy::serial;
+        std::size_t workers = 1;
+        std::size_t frames = 1000;
+        double barrier_cost = 0;    // levels: cost of one barrier
+        double queue_cost = 0;      // work_stealing: one pop or steal; a queue serves one at a time
+        std::uint64_t seed = 1;
+    };
+
+    // Cost models: `double operator()(std::size_t node_index, rng_t& rng)` and `double mean(node_index)`,
+    // node_index being the topological position. Costs are in ticks of any unit.
+
+    template<std::size_t node_count>
+    struct ConstantCosts {
+        std::array<double, node_count> costs {};
+
+        template<typename rng_t>
+        double operator()(std::size_t i, rng_t&) const { return costs[i]; }
+        double mean(std::size_t i) const { return costs[i]; }
+    };
+
+    // Normal distribution per node, clamped at zero
+    template<std::size_t node_count>
+    struct NormalCosts {
+        std::array<double, node_count> means {};
+        std::array<double, node_count> stddevs {};
+
+        template<typename rng_t>
+        double operator()(std::size_t i, rng_t& rng) const {
+            if (stddevs[i] <= 0) {
+                return means[i];
+            }
+            const double c = std::normal_distribution<double>(means[i], stddevs[i])(rng);
+            return c > 0 ? c : 0.0;
+        }
+        double mean(std::size_t i) const { return means[i]; }
+    };
+
+    // Measured distribution: draws a histogram bucket of a NodeProfiler, weighted by its count. A
+    // bucket stands for its midpoint (clamped to the observed min / max), scaled so that the
+    // distribution keeps the measured mean: power of two buckets are too coarse to be used as is.
+    template<std::size_t node_count, std::size_t bucket_count>
+    struct MeasuredCosts {
+        std::array<NodeTimings<bucket_count>, node_count> timings {};
+        std::array<double, node_count> scale {};
+
+        MeasuredCosts() = default;
+
+        template<typename clock_t>
+        explicit MeasuredCosts(const NodeProfiler<node_count, clock_t, bucket_count>& profiler) {
+            for (std::size_t i = 0; i < node_count; ++i) {
+                const auto& t = timings[i] = profiler.timings(i);
+                double sum = 0;
+                for (std::size_t b = 0; b < bucket_count; ++b) {
+                    sum += static_cast<double>(t.histogram[b]) * midpoint(t, b);
+                }
+                scale[i] = sum > 0 ? static_cast<double>(t.total) / sum : 0.0;
+            }
+        }
+
+        static double midpoint(const NodeTimings<bucket_count>& t, std::size_t b) {
+            const double mid = b == 0 ? 0.0 : 0.75 * std::ldexp(1.0, static_cast<int>(b));
+            const double lo = static_cast<double>(t.min);
+            const double hi = static_cast<double>(t.max);
+            return mid < lo ? lo : (mid > hi ? hi : mid);
+        }
+
+        template<typename rng_t>
+        double operator()(std::size_t i, rng_t& rng) const {
+            const auto& t = timings[i];
+            if (t.count == 0) {
+                return 0.0;
+            }
+            auto pick = std::uniform_int_distribution<std::uint64_t>(0, t.count - 1)(rng);
+            std::size_t b = 0;
+            while (b + 1 < bucket_count && pick >= t.histogram[b]) {
+                pick -= t.histogram[b];
+                ++b;
+            }
+            return midpoint(t, b) * scale[i];
+        }
+        double mean(std::size_t i) const { return timings[i].mean(); }
+    };
+
+    // Discrete-event simulation of a graph run by up to max_workers workers under a SchedulePolicy,
+    // frame after frame with costs drawn from a cost model. Meant for offline what-if studies:
+    // predicted frame time percentiles, worker idle time and queue contention.
+    template<typename graph_t, std::size_t max_workers = 16>
+    class ScheduleSimulator {
+
+        using topo_t = typename detail::topology_of<graph_t>::type;
+        static constexpr std::size_t N = topo_t::size();
+        static constexpr std::size_t edge_capacity = topo_t::adjacency().targets.size();
+
+        // Successors and predecessor counts by topological position
+        struct position_graph {
+            std::array<std::size_t, N + 1> offsets {};
+            std::array<std::size_t, edge_capacity> targets {};
+            std::array<std::size_t, N> in_degree {};
+        };
+
+        static constexpr position_graph make_position_graph() {
+            position_graph g {};
+            const auto& adj = topo_t::adjacency();
+            const auto ids = topo_t::ids();
+            std::size_t k = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                const std::size_t v = adj.index_of(ids[i]);
+                g.offsets[i] = k;
+                for (std::size_t e = adj.offsets[v]; e < adj.offsets[v + 1]; ++e) {
+                    const std::size_t dst = topo_t::position_of(adj.ids[adj.targets[e]]);
+                    g.targets[k++] = dst;
+                    ++g.in_degree[dst];
+                }
+            }
+            g.offsets[N] = k;
+            return g;
+        }
+
+        static constexpr position_graph graph = make_position_graph();
+        static constexpr auto levels = topo_t::levels();
+
+        // Task queue of one worker: pushed at the back, popped from the back, stolen from the front.
+        // A node is queued once per frame, so N entries always suffice.
+        struct task_queue {
+            std::array<std::size_t, N == 0 ? 1 : N> nodes {};
+            std::array<double, N == 0 ? 1 : N> available {};
+            std::size_t front = 0;
+            std::size_t back = 0;
+            double busy_until = 0;
+        };
+
+        SimulationOptions mOptions;
+        std::vector<double> mFrameTimes;    // every simulated frame, sorted after each run
+        std::array<std::size_t, N == 0 ? 1 : N> mLane {};
+        std::array<double, N == 0 ? 1 : N> mCost {};
+        std::size_t mWorkers = 1;
+        std::uint64_t mFrames = 0;
+        double mTotalTime = 0;
+        double mWorstTime = 0;
+        double mIdle = 0;
+        double mWait = 0;
+        std::uint64_t mSteals = 0;
+
+        double run_serial() {
+            double t = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                t += mCost[i];
+            }
+            return t;
+        }
+
+        double run_levels() {
+            std::size_t level_count = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                level_count = levels[i] + 1 > level_count ? levels[i] + 1 : level_count;
+            }
+            double t = 0;
+            for (std::size_t l = 0; l < level_count; ++l) {
+                std::array<double, max_workers> busy {};
+                for (std::size_t i = 0; i < N; ++i) {
+                    if (levels[i] != l) {
+                        continue;
+                    }
+                    std::size_t w = 0;
+                    for (std::size_t k = 1; k < mWorkers; ++k) {
+                        w = busy[k] < busy[w] ? k : w;
+                    }
+                    busy[w] += mCost[i];
+                }
+                double span = 0;
+                for (std::size_t k = 0; k < mWorkers; ++k) {
+                    span = busy[k] > span ? busy[k] : span;
+                }
+                t += span + mOptions.barrier_cost;
+            }
+            return t;
+        }
+
+        double run_static_lanes() {
+            std::array<double, max_workers> free {};
+            std::array<double, N == 0 ? 1 : N> ready {};
+            double t = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                const std::size_t w = mLane[i];
+                const double start = free[w] > ready[i] ? free[w] : ready[i];
+                free[w] = start + mCost[i];
+                t = free[w] > t ? free[w] : t;
+                for (std::size_t e = graph.offsets[i]; e < graph.offsets[i + 1]; ++e) {
+                    const std::size_t dst = graph.targets[e];
+                    ready[dst] = free[w] > ready[dst] ? free[w] : ready[dst];
+                }
+            }
+            return t;
+        }
+
+        // One queue operation of a worker at time t: waits for the queue, returns when it is done
+        double queue_op(task_queue& q, double t) {
+            const double start = t > q.busy_until ? t : q.busy_until;
+            mWait += start - t;
+            q.busy_until = start + mOptions.queue_cost;
+            return q.busy_until;
+        }
+
+        double run_work_stealing() {
+            std::array<task_queue, max_workers> queues {};
+            std::array<double, max_workers> free {};
+            std::array<std::size_t, N == 0 ? 1 : N> pending = graph.in_degree;
+            std::array<double, N == 0 ? 1 : N> ready {};
+            std::array<std::size_t, N == 0 ? 1 : N> owner {};
+
+            // The frame starts on worker 0, which queues the sources
+            for (std::size_t i = 0; i < N; ++i) {
+                if (pending[i] == 0) {
+                    auto& q = queues[0];
+                    q.nodes[q.back] = i;
+                    q.available[q.back++] = 0;
+                }
+            }
+
+            double t = 0;
+            for (std::size_t done = 0; done < N; ++done) {
+                // Next start: the worker and queue entry that can begin the earliest
+                std::size_t best_w = 0, best_q = 0, best_slot = 0;
+                double best_start = -1;
+                for (std::size_t w = 0; w < mWorkers; ++w) {
+                    for (std::size_t k = 0; k < mWorkers; ++k) {
+                        auto& q = queues[k];
+                        if (q.front == q.back) {
+                            continue;
+                        }
+                        // Own queue: newest entry, others: oldest entry
+                        const std::size_t slot = k == w ? q.back - 1 : q.front;
+                        const double start = free[w] > q.available[slot] ? free[w] : q.available[slot];
+                        const bool better = best_start < 0 || start < best_start ||
+                            (start == best_start && k == w && best_q != best_w);
+                        if (better) {
+                            best_start = start;
+                            best_w = w;
+                            best_q = k;
+                            best_slot = slot;
+                        }
+                    }
+                }
+
+                auto& q = queues[best_q];
+                const std::size_t node = q.nodes[best_slot];
+                if (best_slot == q.front) {
+                    ++q.front;
+                }
+                else {
+                    --q.back;
+                }
+                if (best_q != best_w) {
+                    ++mSteals;
+                }
+                const double start = queue_op(q, best_start);
+                const double finish = start + mCost[node];
+                free[best_w] = finish;
+                t = finish > t ? finish : t;
+
+                for (std::size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+                    const std::size_t dst = graph.targets[e];
+                    if (finish >= ready[dst]) {
+                        ready[dst] = finish;
+                        owner[dst] = best_w;
+                    }
+                    if (--pending[dst] == 0) {
+                        auto& oq = queues[owner[dst]];
+                        oq.nodes[oq.back] = dst;
+                        oq.available[oq.back++] = ready[dst];
+                    }
+                }
+            }
+            return t;
+        }
+
+        // Longest expected cost first onto the least loaded worker (LPT); each worker then runs its
+        // nodes in topological order
+        template<typename model_t>
+        void assign_lanes(const model_t& model) {
+            std::array<std::size_t, N> order {};
+            std::array<double, N> mean {};
+            for (std::size_t i = 0; i < N; ++i) {
+                mean[i] = model.mean(i);
+                std::size_t k = i;
+                for (; k > 0 && mean[order[k - 1]] < mean[i]; --k) {
+                    order[k] = order[k - 1];
+                }
+                order[k] = i;
+            }
+            std::array<double, max_workers> load {};
+            for (const std::size_t i : order) {
+                std::size_t w = 0;
+                for (std::size_t k = 1; k < mWorkers; ++k) {
+                    w = load[k] < load[w] ? k : w;
+                }
+                mLane[i] = w;
+                load[w] += mean[i];
+            }
+        }
+
+    public:
+
+        static constexpr std::size_t size() { return N; }
+
+        // Simulates options.frames frames, adding to the results of previous runs until reset()
+        template<typename model_t>
+        void run(const SimulationOptions& options, const model_t& model) {
+            mOptions = options;
+            mWorkers = options.policy == SchedulePolicy::serial ? 1 : options.workers;
+            mWorkers = mWorkers == 0 ? 1 : (mWorkers > max_workers ? max_workers : mWorkers);
+            if (options.policy == SchedulePolicy::static_lanes) {
+                assign_lanes(model);
+            }
+
+            mFrameTimes.reserve(mFrameTimes.size() + options.frames);
+            std::mt19937_64 rng(options.seed);
+            for (std::size_t f = 0; f < options.frames; ++f) {
+                double work = 0;
+                for (std::size_t i = 0; i < N; ++i) {
+                    mCost[i] = model(i, rng);
+                    work += mCost[i];
+                }
+                double t = 0;
+                switch (options.policy) {
+                case SchedulePolicy::serial: t = run_serial(); break;
+                case SchedulePolicy::levels: t = run_levels(); break;
+                case SchedulePolicy::work_stealing: t = run_work_stealing(); break;
+                case SchedulePolicy::static_lanes: t = run_static_lanes(); break;
+                }
+                mFrameTimes.push_back(t);
+                mTotalTime += t;
+                mWorstTime = t > mWorstTime ? t : mWorstTime;
+                mIdle += static_cast<double>(mWorkers) * t - work;
+                ++mFrames;
+            }
+            std::sort(mFrameTimes.begin(), mFrameTimes.end());
+        }
+
+        void reset() {
+            mFrameTimes.clear();
+            mFrames = 0;
+            mTotalTime = mWorstTime = mIdle = mWait = 0;
+            mSteals = 0;
+        }
+
+        std::uint64_t frames() const { return mFrames; }
+        double mean() const { return mFrames ? mTotalTime / static_cast<double>(mFrames) : 0.0; }
+        double worst() const { return mWorstTime; }
+
+        // Frame time below which a fraction q of the frames fall (nearest rank, exact)
+        double quantile(double q) const {
+            if (mFrameTimes.empty()) {
+                return 0.0;
+            }
+            const double rank = std::ceil(q * static_cast<double>(mFrameTimes.size()));
+            const std::size_t k = rank < 1.0 ? 0 : static_cast<std::size_t>(rank) - 1;
+            return mFrameTimes[k < mFrameTimes.size() ? k : mFrameTimes.size() - 1];
+        }
+
+        // Share of the worker time not spent running nodes (waiting, barriers, queue operations)
+        double idle_fraction() const {
+            const double capacity = static_cast<double>(mWorkers) * mTotalTime;
+            return capacity > 0 ? mIdle / capacity : 0.0;
+        }
+
+        // Time per frame spent waiting for a queue another worker was using (work_stealing)
+        double contention() const { return mFrames ? mWait / static_cast<double>(mFrames) : 0.0; }
+        double steals() const { return mFrames ? static_cast<double>(mSteals) / static_cast<double>(mFrames) : 0.0; }
+
+        // Worker a node is pinned to by static_lanes, by topological position
+        std::size_t lane_of(std::size_t node_index) const { return mLane[node_index]; }
+    };
+
+} // namespace ugraph
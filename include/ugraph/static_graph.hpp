@@ -0,0 +1,460 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "context.hpp"
+#include "manifest.hpp"
+#include "storage.hpp"
+#include "topology.hpp"
+#include "graph_base.hpp"
+#include "graph_printer.hpp"
+#include "type_traits/type_list.hpp"
+#include "type_traits/edge_traits.hpp"
+#include "type_traits/graph_traits.hpp"
+
+namespace ugraph {
+
+    namespace detail {
+
+        // Port -> slot tables of a statically bound graph, one per data type. Ports of a node are
+        // numbered inputs first, then outputs. Unconnected ports get a dedicated slot appended
+        // after the colored ones so that they can be fed or read from outside the graph.
+        template<typename traits>
+        struct static_slots {
+
+            using topology_t = typename traits::topology_t;
+            using manifest_t = typename traits::manifest_t;
+
+            template<std::size_t I>
+            using node_manifest_t = typename traits::template node_type_at<I>::module_type::Manifest;
+
+            template<typename T, std::size_t I>
+            static constexpr std::size_t input_count() {
+                if constexpr (node_manifest_t<I>::template contains<T>) {
+                    return node_manifest_t<I>::template input_count<T>();
+                }
+                else {
+                    return 0;
+                }
+            }
+
+            template<typename T, std::size_t I>
+            static constexpr std::size_t output_count() {
+                if constexpr (node_manifest_t<I>::template contains<T>) {
+                    return node_manifest_t<I>::template output_count<T>();
+                }
+                else {
+                    return 0;
+                }
+            }
+
+            template<typename T, std::size_t... I>
+            static constexpr auto make_offsets(std::index_sequence<I...>) {
+                std::array<std::size_t, sizeof...(I) + 1> o {};
+                std::size_t k = 0;
+                ((o[I] = k, k += input_count<T, I>() + output_count<T, I>()), ...);
+                o[sizeof...(I)] = k;
+                return o;
+            }
+
+            // First table entry of each node (by topological position), plus the total port count
+            template<typename T>
+            static constexpr auto offsets = make_offsets<T>(std::make_index_sequence<topology_t::size()>{});
+
+            template<typename T>
+            struct table_t {
+                std::array<std::size_t, offsets<T>[topology_t::size()]> slots {};
+                std::size_t count = 0;
+            };
+
+            static constexpr std::size_t slot_or_external(std::size_t idx, std::size_t& external) {
+                return idx != traits::invalid_index ? idx : external++;
+            }
+
+            template<typename T, std::size_t I, std::size_t... ps>
+            static constexpr void fill_inputs(table_t<T>& t, std::size_t& external, std::index_sequence<ps...>) {
+                ((t.slots[offsets<T>[I] + ps] = slot_or_external(traits::template input_index_for<T, I, ps>(), external)), ...);
+            }
+
+            template<typename T, std::size_t I, std::size_t... ps>
+            static constexpr void fill_outputs(table_t<T>& t, std::size_t& external, std::index_sequence<ps...>) {
+                ((t.slots[offsets<T>[I] + input_count<T, I>() + ps] = slot_or_external(traits::template output_index_for<T, I, ps>(), external)), ...);
+            }
+
+            template<typename T, std::size_t... I>
+            static constexpr table_t<T> make_table(std::index_sequence<I...>) {
+                table_t<T> t {};
+                std::size_t external = traits::template coloring_t<T>::data_count();
+                ((
+                    fill_inputs<T, I>(t, external, std::make_index_sequence<input_count<T, I>()>{}),
+                    fill_outputs<T, I>(t, external, std::make_index_sequence<output_count<T, I>()>{})
+                    ), ...);
+                t.count = external;
+                return t;
+            }
+
+            template<typename T>
+            static constexpr table_t<T> table = make_table<T>(std::make_index_sequence<topology_t::size()>{});
+
+            template<typename T>
+            static constexpr std::size_t input_slot(std::size_t node_index, std::size_t port) {
+                return table<T>.slots[offsets<T>[node_index] + port];
+            }
+
+            template<typename T, std::size_t... I>
+            static constexpr auto make_input_counts(std::index_sequence<I...>) {
+                return std::array<std::size_t, sizeof...(I) + 1> { input_count<T, I>()..., 0 };
+            }
+
+            template<typename T>
+            static constexpr auto input_counts = make_input_counts<T>(std::make_index_sequence<topology_t::size()>{});
+
+            template<typename T>
+            static constexpr std::size_t output_slot(std::size_t node_index, std::size_t port) {
+                return table<T>.slots[offsets<T>[node_index] + input_counts<T>[node_index] + port];
+            }
+
+            template<std::size_t... I>
+            static constexpr auto make_graph_data_t(std::index_sequence<I...>) ->
+                std::tuple<std::array<typename manifest_t::template type_at<I>, table<typename manifest_t::template type_at<I>>.count>...>;
+
+            using graph_data_t = decltype(make_graph_data_t(std::make_index_sequence<manifest_t::type_count>{}));
+        };
+
+    } // namespace detail
+
+    // Context of a statically bound graph: every port resolves to a compile-time slot index inside
+    // the graph data, so an access is a fixed offset from the graph object. The context only
+    // carries the graph data address and is created on the fly by StaticGraph::for_each.
+    template<typename slots_t, std::size_t node_index, typename manifest_t>
+    struct StaticContext {
+
+        using graph_data_t = typename slots_t::graph_data_t;
+
+        constexpr explicit StaticContext(graph_data_t& data) : mData(data) {}
+
+        template<typename data_t>
+        static constexpr bool contains() {
+            return manifest_t::template contains<data_t>;
+        }
+
+        template<typename data_t>
+        static constexpr std::size_t input_count() {
+            return manifest_t::template input_count<data_t>();
+        }
+
+        template<typename data_t>
+        static constexpr std::size_t output_count() {
+            return manifest_t::template output_count<data_t>();
+        }
+
+        template<typename data_t>
+        constexpr inline const data_t& input() const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            static_assert(input_count<data_t>() == 1, "This overload is only valid for single-input types");
+            constexpr std::size_t slot = slots_t::template input_slot<data_t>(node_index, 0);
+            return slots<data_t>()[slot];
+        }
+
+        template<typename data_t>
+        constexpr inline data_t& output() {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            static_assert(output_count<data_t>() == 1, "This overload is only valid for single-output types");
+            constexpr std::size_t slot = slots_t::template output_slot<data_t>(node_index, 0);
+            return slots<data_t>()[slot];
+        }
+
+        template<typename data_t>
+        constexpr inline const data_t& input(std::size_t port) const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            return slots<data_t>()[table<data_t>()[offset<data_t>() + port]];
+        }
+
+        template<typename data_t>
+        constexpr inline data_t& output(std::size_t port) {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            return slots<data_t>()[table<data_t>()[offset<data_t>() + input_count<data_t>() + port]];
+        }
+
+        template<typename data_t>
+        constexpr inline auto inputs() const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            static_assert(input_count<data_t>() > 0, "No input ports for this type");
+            if constexpr (contiguous_ports<data_t>(0, input_count<data_t>())) {
+                return ContiguousSpan<const data_t>(slots<data_t>().data() + table<data_t>()[offset<data_t>()], input_count<data_t>());
+            }
+            else {
+                return SlotSpan<const data_t>(slots<data_t>().data(), table<data_t>() + offset<data_t>(), input_count<data_t>());
+            }
+        }
+
+        template<typename data_t>
+        constexpr inline auto outputs() {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            static_assert(output_count<data_t>() > 0, "No output ports for this type");
+            if constexpr (contiguous_ports<data_t>(input_count<data_t>(), output_count<data_t>())) {
+                return ContiguousSpan<data_t>(slots<data_t>().data() + table<data_t>()[offset<data_t>() + input_count<data_t>()], output_count<data_t>());
+            }
+            else {
+                return SlotSpan<data_t>(slots<data_t>().data(), table<data_t>() + offset<data_t>() + input_count<data_t>(), output_count<data_t>());
+            }
+        }
+
+        template<typename data_t>
+        constexpr inline const data_t* input_ptr(std::size_t port) const {
+            return &input<data_t>(port);
+        }
+
+        template<typename data_t>
+        constexpr inline data_t* output_ptr(std::size_t port) const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            return &slots<data_t>()[table<data_t>()[offset<data_t>() + input_count<data_t>() + port]];
+        }
+
+        // Every port of a statically bound graph is backed by a slot
+        template<typename data_t, std::size_t I = 0>
+        constexpr inline bool has_input() const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            return I < input_count<data_t>();
+        }
+
+        template<typename data_t, std::size_t I = 0>
+        constexpr inline bool has_output() const {
+            static_assert(contains<data_t>(), "Type not declared in Manifest");
+            return I < output_count<data_t>();
+        }
+
+        constexpr bool all_ios_connected() const { return true; }
+
+        template<typename... args_t>
+        bool log(const char* format, const args_t&... args) const {
+            return ugraph::log(format, args...);
+        }
+
+    private:
+
+        template<typename data_t>
+        static constexpr std::size_t offset() { return slots_t::template offsets<data_t>[node_index]; }
+
+        template<typename data_t>
+        static constexpr const std::size_t* table() { return slots_t::template table<data_t>.slots.data(); }
+
+        template<typename data_t>
+        static constexpr bool contiguous_ports(std::size_t first, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (table<data_t>()[offset<data_t>() + first + i] != table<data_t>()[offset<data_t>() + first] + i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename data_t>
+        constexpr auto& slots() const {
+            return std::get<slots_t::manifest_t::template index<data_t>()>(mData);
+        }
+
+        graph_data_t& mData;
+    };
+
+    // Graph variant owning its slots: ports are bound at compile time, no init_graph_data step,
+    // no per-node context storage. Modules must accept any context type, e.g.
+    //   template<typename context_t> void process(context_t& ctx);
+    template<typename... edges_t>
+    class StaticGraph :
+        public detail::node_visitor<StaticGraph<edges_t...>>,
+        public detail::edge_graph_base<StaticGraph<edges_t...>, detail::data_graph_traits<edges_t...>> {
+
+        friend class detail::node_visitor<StaticGraph>;
+
+        using traits = detail::data_graph_traits<edges_t...>;
+        using topology_t = typename traits::topology_t;
+        static_assert(!topology_t::is_cyclic(), "Cycle detected in graph definition");
+
+        using slots_t = detail::static_slots<traits>;
+
+        template<std::size_t I>
+        using node_type_at = typename traits::template node_type_at<I>;
+
+        template<std::size_t I>
+        using context_at = StaticContext<slots_t, I, typename node_type_at<I>::module_type::Manifest>;
+
+        using manifest_t = typename traits::manifest_t;
+        using modules_tuple_impl_t = typename traits::modules_tuple_t;
+
+    public:
+
+        using topology_type = topology_t;
+        using Manifest = manifest_t;
+        using vertex_types_list_public = typename topology_t::vertex_types_list_public;
+        using edge_types_list_public = typename traits::flattened_edges_t;
+        using graph_data_t = typename slots_t::graph_data_t;
+
+    private:
+
+        template<std::size_t... I>
+        static constexpr auto make_storage_tuple_t(std::index_sequence<I...>) ->
+            std::tuple<detail::slot_storage<
+            typename manifest_t::template type_at<I>,
+            slots_t::template table<typename manifest_t::template type_at<I>>.count
+            >...>;
+
+        using storage_tuple_t = decltype(make_storage_tuple_t(std::make_index_sequence<manifest_t::type_count>{}));
+
+        modules_tuple_impl_t mModules;
+        graph_data_t mData {};
+        storage_tuple_t mStorage;
+        std::size_t mMaxViewSize = 0;
+
+    public:
+
+        constexpr StaticGraph(const edges_t&... es) :
+            mModules(traits::build_modules(std::make_index_sequence<topology_t::size()>{}, es...)) {}
+
+        static constexpr auto ids() { return topology_t::ids(); }
+        static constexpr std::size_t size() { return topology_t::size(); }
+        static constexpr auto edges() { return topology_t::edges(); }
+        static constexpr const auto& adjacency() { return topology_t::adjacency(); }
+        static constexpr auto entry_ids() { return topology_t::entry_ids(); }
+        static constexpr auto exit_ids() { return topology_t::exit_ids(); }
+
+        template<std::size_t node_id>
+        static constexpr bool contains_node_id() { return topology_t::template has_id<node_id>(); }
+
+        // Topological position of a node id, size() when absent. Usable at run time.
+        static constexpr std::size_t position_of(std::size_t node_id) { return topology_t::position_of(node_id); }
+
+        template<std::size_t node_id>
+        constexpr auto module_ptr_by_id()
+            -> typename topology_t::template find_type_by_id<node_id>::type::module_type* {
+            return std::get<node_index_of<node_id>()>(mModules);
+        }
+
+        // Slots shared by connected ports (same as Graph::data_count)
+        template<typename data_t>
+        static constexpr std::size_t data_count() {
+            return traits::template coloring_t<data_t>::data_count();
+        }
+
+        // All slots, including the dedicated slots of unconnected ports
+        template<typename data_t>
+        static constexpr std::size_t slot_count() {
+            return slots_t::template table<data_t>.count;
+        }
+
+        constexpr graph_data_t& graph_data() { return mData; }
+        constexpr const graph_data_t& graph_data() const { return mData; }
+
+        template<typename data_t>
+        constexpr data_t& data_at(std::size_t i) {
+            return std::get<manifest_t::template index<data_t>()>(mData)[i];
+        }
+
+        // Slot behind a node port, typically used to feed or read ports left unconnected in the graph
+        template<std::size_t node_id, typename data_t>
+        constexpr data_t& input() {
+            static_assert(node_manifest_t<node_id>::template input_count<data_t>() == 1, "Only valid for single-input types; use input_at");
+            return input_at<node_id, 0, data_t>();
+        }
+
+        template<std::size_t node_id, std::size_t input_index, typename data_t>
+        constexpr data_t& input_at() {
+            static_assert(input_index < node_manifest_t<node_id>::template input_count<data_t>(), "Invalid input index for this node/type");
+            constexpr std::size_t slot = slots_t::template input_slot<data_t>(node_index_of<node_id>(), input_index);
+            return data_at<data_t>(slot);
+        }
+
+        template<std::size_t node_id, typename data_t>
+        constexpr data_t& output() {
+            static_assert(node_manifest_t<node_id>::template output_count<data_t>() == 1, "Only valid for single-output types; use output_at");
+            return output_at<node_id, 0, data_t>();
+        }
+
+        template<std::size_t node_id, std::size_t output_index, typename data_t>
+        constexpr data_t& output_at() {
+            static_assert(output_index < node_manifest_t<node_id>::template output_count<data_t>(), "Invalid output index for this node/type");
+            constexpr std::size_t slot = slots_t::template output_slot<data_t>(node_index_of<node_id>(), output_index);
+            return data_at<data_t>(slot);
+        }
+
+        // See Graph::prepare; views are wired immediately since the slots live in the graph.
+        void prepare(std::size_t max_size) {
+            mMaxViewSize = max_size;
+            std::apply([&] (auto&... storages) { (storages.allocate(max_size), ...); }, mStorage);
+            resize_views(max_size);
+        }
+
+        template<typename arena_t>
+        bool prepare(std::size_t max_size, arena_t& arena) {
+            mMaxViewSize = max_size;
+            const bool ok = std::apply([&] (auto&... storages) { return (storages.allocate(max_size, arena) & ... & true); }, mStorage);
+            resize_views(max_size);
+            return ok;
+        }
+
+        void resize_views(std::size_t size) {
+            if (size > mMaxViewSize) {
+                size = mMaxViewSize;
+            }
+            resize_views_impl(size, std::make_index_sequence<manifest_t::type_count>{});
+        }
+
+    private:
+
+        template<std::size_t node_id>
+        static constexpr std::size_t node_index_of() {
+            static_assert(contains_node_id<node_id>(), "Invalid node id");
+            return topology_t::position_of(node_id);
+        }
+
+        template<std::size_t node_id>
+        using node_manifest_t = typename node_type_at<node_index_of<node_id>()>::module_type::Manifest;
+
+        template<std::size_t I, typename F>
+        constexpr void for_each_at(F&& f) {
+            context_at<I> ctx(mData);
+            f(*std::get<I>(mModules), ctx);
+        }
+
+        template<std::size_t... I>
+        void resize_views_impl(std::size_t size, std::index_sequence<I...>) {
+            (std::get<I>(mStorage).wire(std::get<I>(mData), size), ...);
+        }
+
+    };
+
+    template<typename E0, typename... ERest>
+    StaticGraph(E0 const&, ERest const&...) -> StaticGraph<std::decay_t<E0>, std::decay_t<ERest>...>;
+
+} // namespace ugraph
@@ -0,0 +1,259 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#pragma once
+
+#include <new>
+#include <tuple>
+#include <memory>
+#include <numeric>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+namespace ugraph {
+
+    // Alignment used for graph-owned memory (one cache line, wide enough for AVX-512 loads).
+    inline constexpr std::size_t cache_line_size = 64;
+
+    // Storage policy for "view" data types, i.e. types that only reference memory (pointer + size).
+    // The graph allocates one aligned block of `element_t` per slot and builds the views itself.
+    template<typename element_t, std::size_t _alignment = cache_line_size>
+    struct BufferStorage {
+
+        static_assert((_alignment & (_alignment - 1)) == 0, "Alignment must be a power of two");
+        static_assert(_alignment >= alignof(element_t), "Alignment is smaller than the element alignment");
+        static_assert(std::is_trivially_destructible_v<element_t>, "Backing elements must be trivially destructible");
+
+        using element_type = element_t;
+
+        static constexpr std::size_t alignment() { return _alignment; }
+
+        template<typename view_t>
+        static constexpr view_t make_view(element_type* data, std::size_t size) {
+            return view_t(data, size);
+        }
+    };
+
+    // A data type opts in either by declaring `using storage_policy = ...;`
+    // or by specializing `ugraph::storage_policy<T>`.
+    template<typename data_t, typename = void>
+    struct storage_policy { using type = void; };
+
+    template<typename data_t>
+    struct storage_policy<data_t, std::void_t<typename data_t::storage_policy>> {
+        using type = typename data_t::storage_policy;
+    };
+
+    template<typename data_t>
+    inline constexpr bool has_storage_policy = !std::is_void_v<typename storage_policy<data_t>::type>;
+
+    // Execution schedules a graph data layout can be specialized for. step(position, level) orders
+    // the nodes for slot reuse: nodes of one step may run at the same time, steps run in order.
+    // Serial: one node runs at a time, slots are never accessed concurrently.
+    struct SerialSchedule {
+        static constexpr bool concurrent(std::size_t, std::size_t) { return false; }
+        static constexpr std::size_t step(std::size_t position, std::size_t) { return position; }
+    };
+
+    // Levels: every node of a topological level may run at the same time on a different core,
+    // levels are separated by a barrier.
+    struct LevelSchedule {
+        static constexpr bool concurrent(std::size_t level_a, std::size_t level_b) { return level_a == level_b; }
+        static constexpr std::size_t step(std::size_t, std::size_t level) { return level; }
+    };
+
+    // Slot owning its own cache line(s), so that writes from one core do not invalidate its neighbours.
+    template<typename data_t>
+    struct alignas(cache_line_size) PaddedSlot {
+        data_t value;
+    };
+
+    namespace detail {
+
+        template<std::size_t I, typename module_t>
+        struct module_slot {
+            constexpr explicit module_slot(const module_t& m) : value(m) {}
+            alignas(cache_line_size) module_t value;
+        };
+
+        template<typename seq_t, typename... modules_t>
+        struct module_store_impl;
+
+        // Bases are laid out in declaration order, so modules follow the topological order in memory
+        template<std::size_t... I, typename... modules_t>
+        struct module_store_impl<std::index_sequence<I...>, modules_t...> : module_slot<I, modules_t>... {
+
+            constexpr explicit module_store_impl(modules_t*... modules) : module_slot<I, modules_t>(*modules)... {}
+
+            template<std::size_t J, typename module_t>
+            static constexpr module_t& element(module_slot<J, module_t>& s) { return s.value; }
+
+            template<std::size_t J, typename module_t>
+            static constexpr const module_t& element(const module_slot<J, module_t>& s) { return s.value; }
+        };
+
+    } // namespace detail
+
+    // Module storage of a graph, indexed by topological position and built from the modules
+    // given to make_node. ModuleRefs keeps pointers to them, the caller owns the modules.
+    template<typename... modules_t>
+    class ModuleRefs {
+    public:
+        constexpr explicit ModuleRefs(modules_t*... modules) : mModules(modules...) {}
+
+        template<std::size_t I>
+        constexpr auto& get() const { return *std::get<I>(mModules); }
+
+        template<std::size_t I>
+        constexpr auto* ptr() const { return std::get<I>(mModules); }
+
+    private:
+        std::tuple<modules_t*...> mModules;
+    };
+
+    // ModuleStore copies the modules into the graph, one after the other in topological order,
+    // each starting on its own cache line. The modules given to make_node only act as prototypes.
+    template<typename... modules_t>
+    class ModuleStore : detail::module_store_impl<std::index_sequence_for<modules_t...>, modules_t...> {
+
+        using impl_t = detail::module_store_impl<std::index_sequence_for<modules_t...>, modules_t...>;
+
+    public:
+        constexpr explicit ModuleStore(modules_t*... modules) : impl_t(modules...) {}
+
+        template<std::size_t I>
+        constexpr auto& get() { return impl_t::template element<I>(static_cast<impl_t&>(*this)); }
+
+        template<std::size_t I>
+        constexpr const auto& get() const { return impl_t::template element<I>(static_cast<const impl_t&>(*this)); }
+
+        template<std::size_t I>
+        constexpr auto* ptr() { return &get<I>(); }
+    };
+
+    namespace detail {
+
+        template<typename slot_t>
+        struct slot_element { using type = slot_t; };
+
+        template<typename data_t>
+        struct slot_element<PaddedSlot<data_t>> { using type = data_t; };
+
+        template<typename data_t>
+        constexpr data_t& slot_value(data_t& slot) { return slot; }
+
+        template<typename data_t>
+        constexpr data_t& slot_value(PaddedSlot<data_t>& slot) { return slot.value; }
+
+        // Backing memory for the slots of one data type. Empty for types without a storage policy.
+        // slot_count is the default number of blocks, a layout with more slots passes its own.
+        template<typename data_t, std::size_t slot_count, bool = has_storage_policy<data_t>>
+        struct slot_storage {
+            constexpr void allocate(std::size_t, std::size_t = slot_count) {}
+            template<typename arena_t>
+            constexpr bool allocate(std::size_t, arena_t&, std::size_t = slot_count) { return true; }
+            template<typename array_t>
+            constexpr void wire(array_t&, std::size_t) {}
+        };
+
+        template<typename data_t, std::size_t slot_count>
+        class slot_storage<data_t, slot_count, true> {
+
+            using policy_t = typename storage_policy<data_t>::type;
+            using element_t = typename policy_t::element_type;
+            static constexpr std::size_t alignment = policy_t::alignment();
+
+            // Blocks taken from an arena are released with the arena, not by the storage
+            struct block_delete {
+                bool owned = true;
+                void operator()(void* p) const {
+                    if (owned) {
+                        ::operator delete(p, std::align_val_t { alignment });
+                    }
+                }
+            };
+
+            std::unique_ptr<void, block_delete> mBlock;
+            std::size_t mStride = 0; // in elements, keeps every slot aligned
+            std::size_t mCount = slot_count;
+
+            // Smallest element count spanning a whole number of alignments, e.g. 8 elements of 24
+            // bytes for 64 byte alignment. Strides are a multiple of it so that every slot is aligned.
+            static constexpr std::size_t stride_step = alignment / std::gcd(alignment, sizeof(element_t));
+
+            std::size_t reset(std::size_t max_size, std::size_t count) {
+                mStride = ((max_size + stride_step - 1) / stride_step) * stride_step;
+                mCount = count;
+                mBlock.reset();
+                return mStride * mCount * sizeof(element_t);
+            }
+
+            void adopt(void* block, bool owned) {
+                mBlock = std::unique_ptr<void, block_delete>(block, block_delete { owned });
+                if (block != nullptr) {
+                    std::uninitialized_value_construct_n(static_cast<element_t*>(block), mStride * mCount);
+                }
+            }
+
+        public:
+
+            void allocate(std::size_t max_size, std::size_t count = slot_count) {
+                const std::size_t bytes = reset(max_size, count);
+                if (bytes > 0) {
+                    adopt(::operator new(bytes, std::align_val_t { alignment }), true);
+                }
+            }
+
+            // Returns false when the arena cannot hold the blocks.
+            template<typename arena_t>
+            bool allocate(std::size_t max_size, arena_t& arena, std::size_t count = slot_count) {
+                const std::size_t bytes = reset(max_size, count);
+                if (bytes == 0) {
+                    return true;
+                }
+                void* block = arena.allocate(bytes, alignment);
+                adopt(block, false);
+                return block != nullptr;
+            }
+
+            element_t* slot(std::size_t i) const {
+                return mBlock ? static_cast<element_t*>(mBlock.get()) + i * mStride : nullptr;
+            }
+
+            template<typename array_t>
+            void wire(array_t& arr, std::size_t size) {
+                for (std::size_t i = 0; i < mCount && i < arr.size(); ++i) {
+                    slot_value(arr[i]) = policy_t::template make_view<data_t>(slot(i), mBlock ? size : 0);
+                }
+            }
+        };
+
+    } // namespace detail
+
+} // namespace ugraph
@@ -35,6 +35,7 @@
 
 #include "graph_printer.hpp"
 #include "type_traits/type_list.hpp"
+#include "type_traits/adjacency.hpp"
 #include "type_traits/edge_traits.hpp"
 
 namespace ugraph {
@@ -142,11 +143,10 @@ namespace ugraph {
         static constexpr auto vertex_ids = make_vertex_ids(std::make_index_sequence<vertex_count>{});
 
         static constexpr bool has_duplicate_vertex_ids() {
-            for (std::size_t i = 0; i < vertex_count; ++i) {
-                for (std::size_t j = i + 1; j < vertex_count; ++j) {
-                    if (vertex_ids[i] == vertex_ids[j]) {
-                        return true;
-                    }
+            const auto sorted = detail::make_id_map(vertex_ids);
+            for (std::size_t i = 1; i < vertex_count; ++i) {
+                if (sorted.keys[i - 1] == sorted.keys[i]) {
+                    return true;
                 }
             }
             return false;
@@ -179,84 +179,44 @@ namespace ugraph {
             }
         }
 
-        // Instead of exposing all inner vertices, we want to map edges to module boundary nodes:
-        // - entry nodes: inner nodes with no incoming edges
-        // - exit nodes: inner nodes with no outgoing edges
-        // Provide constexpr helpers to count and access these ids for a module Topology type M.
+        // Instead of exposing all inner vertices, edges to or from a nested module map to its
+        // boundary nodes: entries (no incoming edge) and exits (no outgoing edge). Every Topology
+        // caches both sets once as constexpr arrays, see entry_ids() / exit_ids().
         template<typename M, typename = void>
         struct module_entry_count { static constexpr std::size_t value = 1; };
         template<typename M>
         struct module_entry_count<M, std::void_t<typename M::vertex_types_list_public>> {
-            static constexpr std::size_t compute() {
-                constexpr auto ids = M::ids();
-                constexpr auto edges = M::edges();
-                std::size_t c = 0;
-                for (std::size_t i = 0; i < ids.size(); ++i) {
-                    bool has_in = false;
-                    for (std::size_t j = 0; j < edges.size(); ++j) {
-                        if (edges[j].second == ids[i]) { has_in = true; break; }
-                    }
-                    if (!has_in) ++c;
-                }
-                return c;
-            }
-            static constexpr std::size_t value = compute();
+            static constexpr std::size_t value = M::entry_ids().size();
         };
 
         template<typename M, typename = void>
         struct module_exit_count { static constexpr std::size_t value = 1; };
         template<typename M>
         struct module_exit_count<M, std::void_t<typename M::vertex_types_list_public>> {
-            static constexpr std::size_t compute() {
-                constexpr auto ids = M::ids();
-                constexpr auto edges = M::edges();
-                std::size_t c = 0;
-                for (std::size_t i = 0; i < ids.size(); ++i) {
-                    bool has_out = false;
-                    for (std::size_t j = 0; j < edges.size(); ++j) {
-                        if (edges[j].first == ids[i]) { has_out = true; break; }
-                    }
-                    if (!has_out) ++c;
-                }
-                return c;
-            }
-            static constexpr std::size_t value = compute();
+            static constexpr std::size_t value = M::exit_ids().size();
         };
 
-        template<typename M, std::size_t K, std::size_t Base = 0>
-        static constexpr std::size_t module_entry_id_at() {
-            constexpr auto ids = M::ids();
-            constexpr auto edges = M::edges();
-            std::size_t found = 0;
-            for (std::size_t i = 0; i < ids.size(); ++i) {
-                bool has_in = false;
-                for (std::size_t j = 0; j < edges.size(); ++j) {
-                    if (edges[j].second == ids[i]) { has_in = true; break; }
-                }
-                if (!has_in) {
-                    if (found == K) return Base + ids[i];
-                    ++found;
-                }
+        // Ids an edge endpoint expands to: the vertex itself, or the shifted boundary of its module
+        template<typename V, bool entries>
+        static constexpr auto endpoint_ids() {
+            using M = typename V::module_type;
+            if constexpr (!has_vertex_types_list<M>::value) {
+                return std::array<std::size_t, 1>{ V::id() };
             }
-            return (std::size_t) 0;
-        }
-
-        template<typename M, std::size_t K, std::size_t Base = 0>
-        static constexpr std::size_t module_exit_id_at() {
-            constexpr auto ids = M::ids();
-            constexpr auto edges = M::edges();
-            std::size_t found = 0;
-            for (std::size_t i = 0; i < ids.size(); ++i) {
-                bool has_out = false;
-                for (std::size_t j = 0; j < edges.size(); ++j) {
-                    if (edges[j].first == ids[i]) { has_out = true; break; }
-                }
-                if (!has_out) {
-                    if (found == K) return Base + ids[i];
-                    ++found;
+            else {
+                auto ids = [] () constexpr {
+                    if constexpr (entries) {
+                        return M::entry_ids();
+                    }
+                    else {
+                        return M::exit_ids();
+                    }
+                    }();
+                for (auto& id : ids) {
+                    id += V::id();
                 }
+                return ids;
             }
-            return (std::size_t) 0;
         }
 
         template<typename Edge>
@@ -268,7 +228,6 @@ namespace ugraph {
             static constexpr std::size_t value = s * d;
         };
 
-        static constexpr std::size_t edge_count = sizeof...(edges_t);
         static constexpr std::size_t total_expanded_edges = (expanded_edge_size<edges_t>::value + ...);
 
         // Compute total expanded edges coming from nested module-vertices declared in this topology
@@ -286,168 +245,161 @@ namespace ugraph {
             static constexpr std::size_t value = ((module_edges_count<typename Vs::module_type>::value) + ... + 0);
         };
 
-        template<typename Edge, std::size_t K>
-        static constexpr std::pair<std::size_t, std::size_t> pair_for_edge_const() {
-            using S = typename detail::edge_traits<Edge>::src_vertex_t;
-            using D = typename detail::edge_traits<Edge>::dst_vertex_t;
-            constexpr bool S_is_module = has_vertex_types_list<typename S::module_type>::value;
-            constexpr bool D_is_module = has_vertex_types_list<typename D::module_type>::value;
-            if constexpr (S_is_module && D_is_module) {
-                constexpr std::size_t d = module_entry_count<typename D::module_type>::value;
-                constexpr std::size_t src_idx = K / d;
-                constexpr std::size_t dst_idx = K % d;
-                constexpr std::size_t sid = module_exit_id_at<typename S::module_type, src_idx, S::id()>();
-                constexpr std::size_t did = module_entry_id_at<typename D::module_type, dst_idx, D::id()>();
-                return { sid, did };
-            }
-            else if constexpr (S_is_module && !D_is_module) {
-                constexpr std::size_t sid = module_exit_id_at<typename S::module_type, K, S::id()>();
-                return { sid, D::id() };
-            }
-            else if constexpr (!S_is_module && D_is_module) {
-                constexpr std::size_t d = module_entry_count<typename D::module_type>::value;
-                constexpr std::size_t dst_idx = K % d;
-                return { S::id(), module_entry_id_at<typename D::module_type, dst_idx, D::id()>() };
-            }
-            else {
-                return { S::id(), D::id() };
-            }
+        // Total edges = nested module edges + top-level expanded edges
+        static constexpr std::size_t nested_total = declared_nested_edges_total<declared_vertex_types_list>::value;
+        static constexpr std::size_t all_total_expanded_edges = nested_total + total_expanded_edges;
+
+        using edge_ids_t = std::array<std::pair<std::size_t, std::size_t>, all_total_expanded_edges>;
+
+        static constexpr void push_edge(edge_ids_t& out, std::size_t& n, std::size_t src, std::size_t dst) {
+            out[n].first = src;
+            out[n].second = dst;
+            ++n;
         }
 
-        template<std::size_t K, std::size_t I = 0>
-        static constexpr std::pair<std::size_t, std::size_t> find_pair_const() {
-            if constexpr (I >= edge_count) {
-                return { 0, 0 };
-            }
-            else {
-                using Edge = typename detail::type_list_at<I, detail::type_list<edges_t...>>::type;
-                constexpr std::size_t sz = expanded_edge_size<Edge>::value;
-                if constexpr (K < sz) {
-                    return pair_for_edge_const<Edge, K>();
-                }
-                else {
-                    return find_pair_const<K - sz, I + 1>();
+        // Internal edges of a declared vertex wrapping a nested module, shifted by its id
+        template<typename V>
+        static constexpr void push_nested_edges(edge_ids_t& out, std::size_t& n) {
+            if constexpr (has_vertex_types_list<typename V::module_type>::value) {
+                constexpr auto m_edges = V::module_type::edges();
+                for (const auto& e : m_edges) {
+                    push_edge(out, n, V::id() + e.first, V::id() + e.second);
                 }
             }
         }
 
-        // Find K-th nested-module edge across declared vertices (declared_vertex_types_list)
-        template<std::size_t K, std::size_t I = 0>
-        static constexpr std::pair<std::size_t, std::size_t> find_nested_pair_const() {
-            using declared = declared_vertex_types_list;
-            constexpr std::size_t D = detail::type_list_size<declared>::value;
-            if constexpr (I >= D) {
-                return { 0, 0 };
-            }
-            else {
-                using vt = typename detail::type_list_at<I, declared>::type;
-                if constexpr (!has_vertex_types_list<typename vt::module_type>::value) {
-                    return find_nested_pair_const<K, I + 1>();
-                }
-                else {
-                    constexpr auto m_edges = vt::module_type::edges();
-                    constexpr std::size_t msz = m_edges.size();
-                    if constexpr (K < msz) {
-                        return std::pair<std::size_t, std::size_t> { vt::id() + m_edges[K].first, vt::id() + m_edges[K].second };
-                    }
-                    else {
-                        return find_nested_pair_const<K - msz, I + 1>();
-                    }
+        // Declared edge expanded from every exit of its source to every entry of its destination
+        template<typename Edge>
+        static constexpr void push_expanded_edges(edge_ids_t& out, std::size_t& n) {
+            constexpr auto srcs = endpoint_ids<typename detail::edge_traits<Edge>::src_vertex_t, false>();
+            constexpr auto dsts = endpoint_ids<typename detail::edge_traits<Edge>::dst_vertex_t, true>();
+            for (std::size_t s : srcs) {
+                for (std::size_t d : dsts) {
+                    push_edge(out, n, s, d);
                 }
             }
         }
 
-        // Total edges = nested module edges + top-level expanded edges
-        static constexpr std::size_t nested_total = declared_nested_edges_total<declared_vertex_types_list>::value;
-        static constexpr std::size_t all_total_expanded_edges = nested_total + total_expanded_edges;
-
-        template<std::size_t... I>
-        static constexpr auto make_edges_ids_impl(std::index_sequence<I...>) {
-            return std::array<std::pair<std::size_t, std::size_t>, sizeof...(I)>{ (I < nested_total ? find_nested_pair_const<I>() : find_pair_const<I - nested_total>())... };
-        }
-
-        static constexpr auto make_edges_ids() {
-            return make_edges_ids_impl(std::make_index_sequence<all_total_expanded_edges>{});
+        template<typename... Vs>
+        static constexpr edge_ids_t make_edges_ids(detail::type_list<Vs...>) {
+            edge_ids_t out {};
+            std::size_t n = 0;
+            (push_nested_edges<Vs>(out, n), ...);
+            (push_expanded_edges<edges_t>(out, n), ...);
+            return out;
         }
 
-        static constexpr auto edges_ids = make_edges_ids();
+        static constexpr auto edges_ids = make_edges_ids(declared_vertex_types_list {});
 
         // Provide a public alias so nested Topology types can expose their vertex list
     public:
         using vertex_types_list_public = vertex_types_list;
 
-        // Kahn topological sort executed at compile time.
+        // CSR adjacency over the flattened vertices, indexed in declared order
+        static constexpr auto adjacency_csr = detail::make_adjacency(vertex_ids, edges_ids);
+
+        // Kahn topological sort executed at compile time. Ready vertices wait in a heap keyed by
+        // priority, ties going to the earliest declared vertex: O((V + E) log V).
         struct topo_result {
             std::array<std::size_t, vertex_count> order {};
             bool has_cycle = false;
         };
         static constexpr topo_result compute_topology() {
             topo_result r {};
-            std::array<std::size_t, vertex_count> indeg {};
-            auto id2idx =
-                [] (std::size_t id) constexpr {
-                for (std::size_t i = 0; i < vertex_count; ++i) {
-                    if (vertex_ids[i] == id) {
-                        return i;
-                    }
-                }
-                return (std::size_t) vertex_count;
-                };
-            for (std::size_t ei = 0; ei < edges_ids.size(); ++ei) {
-                auto& e = edges_ids[ei];
-                auto idx = id2idx(e.second);
-                if (idx < vertex_count) {
-                    ++indeg[idx];
+            const auto& adj = adjacency_csr;
+            auto indeg = adj.in_degree;
+            detail::ready_queue<vertex_count> ready {};
+            for (std::size_t i = 0; i < vertex_count; ++i) {
+                if (indeg[i] == 0) {
+                    ready.push(i, vertex_priorities);
                 }
             }
-            std::array<bool, vertex_count> used {};
             std::size_t placed = 0;
-            while (placed < vertex_count) {
-                std::size_t pick = vertex_count;
-                std::size_t best_prio = 0;
-                bool found = false;
-                for (std::size_t i = 0; i < vertex_count; ++i) {
-                    if (!used[i] && indeg[i] == 0) {
-                        auto pr = vertex_priorities[i];
-                        if (!found || pr > best_prio) {
-                            best_prio = pr;
-                            pick = i;
-                            found = true;
-                        }
-                    }
-                }
-                if (!found) { // cycle: return original order for determinism
-                    r.has_cycle = true;
-                    for (std::size_t i = 0; i < vertex_count; ++i) {
-                        r.order[i] = vertex_ids[i];
-                    }
-                    return r;
-                }
+            while (!ready.empty()) {
+                const std::size_t pick = ready.pop(vertex_priorities);
                 r.order[placed++] = vertex_ids[pick];
-                used[pick] = true;
-                for (std::size_t ei = 0; ei < edges_ids.size(); ++ei) {
-                    auto& e = edges_ids[ei];
-                    if (e.first == vertex_ids[pick]) {
-                        auto idx = id2idx(e.second);
-                        if (idx < vertex_count && indeg[idx] > 0) {
-                            --indeg[idx];
-                        }
+                for (std::size_t k = adj.offsets[pick]; k < adj.offsets[pick + 1]; ++k) {
+                    if (--indeg[adj.targets[k]] == 0) {
+                        ready.push(adj.targets[k], vertex_priorities);
                     }
                 }
             }
+            if (placed < vertex_count) { // cycle: return original order for determinism
+                r.has_cycle = true;
+                for (std::size_t i = 0; i < vertex_count; ++i) {
+                    r.order[i] = vertex_ids[i];
+                }
+            }
             return r;
         }
 
         static constexpr auto topo = compute_topology();
 
-        // Mapping from vertex id -> vertex type
-        template<std::size_t Id, typename V, typename... Vs>
+        // Vertex id -> topological position
+        static constexpr auto positions = detail::make_id_map(topo.order);
+
+        // Boundary of this topology, in topological order: entries have no incoming edge, exits
+        // no outgoing edge. Edges to or from this topology nested in another one attach there.
+        template<bool entries>
+        static constexpr bool is_boundary(std::size_t id) {
+            const std::size_t v = adjacency_csr.index_of(id);
+            return (entries ? adjacency_csr.in_degree[v] : adjacency_csr.out_degree(v)) == 0;
+        }
+
+        template<bool entries>
+        static constexpr std::size_t count_boundary() {
+            std::size_t c = 0;
+            for (std::size_t i = 0; i < vertex_count; ++i) {
+                c += is_boundary<entries>(topo.order[i]) ? 1 : 0;
+            }
+            return c;
+        }
+
+        template<bool entries>
+        static constexpr auto make_boundary() {
+            std::array<std::size_t, count_boundary<entries>()> ids {};
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < vertex_count; ++i) {
+                if (is_boundary<entries>(topo.order[i])) {
+                    ids[n++] = topo.order[i];
+                }
+            }
+            return ids;
+        }
+
+        static constexpr auto entry_boundary = make_boundary<true>();
+        static constexpr auto exit_boundary = make_boundary<false>();
+
+        // Level of each vertex, indexed by topological position: 0 for sources, otherwise one more
+        // than the deepest predecessor. Vertices sharing a level have no path between them.
+        static constexpr auto compute_levels() {
+            std::array<std::size_t, vertex_count> lv {};
+            if (topo.has_cycle) {
+                return lv;
+            }
+            const auto& adj = adjacency_csr;
+            for (std::size_t i = 0; i < vertex_count; ++i) {
+                const std::size_t v = adj.index_of(topo.order[i]);
+                for (std::size_t k = adj.offsets[v]; k < adj.offsets[v + 1]; ++k) {
+                    const std::size_t dst = positions.find(vertex_ids[adj.targets[k]]);
+                    if (lv[dst] < lv[i] + 1) {
+                        lv[dst] = lv[i] + 1;
+                    }
+                }
+            }
+            return lv;
+        }
+
+        static constexpr auto vertex_levels = compute_levels();
+
+        // Mapping from vertex id -> vertex type: one table lookup, then a constant-depth type_list_at
+        template<std::size_t Id, std::size_t Index = adjacency_csr.index_of(Id)>
         struct find_impl {
-            using type = std::conditional_t<(V::id() == Id), V, typename find_impl<Id, Vs...>::type>;
+            using type = typename detail::type_list_at<Index, vertex_types_list>::type;
         };
-        template<std::size_t Id, typename V>
-        struct find_impl<Id, V> {
-            using type = std::conditional_t<(V::id() == Id), V, void>;
+        template<std::size_t Id>
+        struct find_impl<Id, detail::npos> {
+            using type = void;
         };
 
         template<std::size_t... I, typename F>
@@ -474,6 +426,9 @@ namespace ugraph {
         static constexpr auto ids() { return topo.order; }
         static constexpr std::size_t size() { return vertex_count; }
         static constexpr auto edges() { return edges_ids; }
+        static constexpr auto levels() { return vertex_levels; }
+        static constexpr auto entry_ids() { return entry_boundary; }
+        static constexpr auto exit_ids() { return exit_boundary; }
 
         template<std::size_t I>
         static constexpr std::size_t id_at() {
@@ -482,21 +437,22 @@ namespace ugraph {
         }
 
         template<std::size_t Id>
-        static constexpr bool has_id() {
-            for (std::size_t i = 0; i < vertex_count; ++i) {
-                if (topo.order[i] == Id) {
-                    return true;
-                }
-            }
-            return false;
+        static constexpr bool has_id() { return positions.contains(Id); }
+
+        // Topological position of a vertex id, size() when absent. O(log V).
+        static constexpr std::size_t position_of(std::size_t id) {
+            const std::size_t pos = positions.find(id);
+            return pos == detail::npos ? vertex_count : pos;
         }
 
+        // CSR adjacency of the flattened graph. Vertex indices follow declaration order; use
+        // adjacency().index_of(id) to map an id and adjacency().ids to map back.
+        static constexpr const auto& adjacency() { return adjacency_csr; }
+
         // Query vertex type by id at compile-time: Topology::find_type_by_id<VID>::type
         template<std::size_t Id>
         struct find_type_by_id {
-            template<std::size_t... I>
-            static auto helper(std::index_sequence<I...>) -> typename find_impl<Id, typename detail::type_list_at<I, vertex_types_list>::type...>::type;
-            using type = decltype(helper(std::make_index_sequence<vertex_count>{}));
+            using type = typename find_impl<Id>::type;
             static_assert(!std::is_void_v<type>, "Vertex id not found");
         };
 
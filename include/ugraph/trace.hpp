@@ -0,0 +1,209 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "graph_printer.hpp"
+#include "profiling.hpp"
+#include "storage.hpp"
+#include "type_traits/type_list.hpp"
+
+namespace ugraph {
+
+    namespace detail {
+
+        // Display names of the nodes of a graph, by topological (or plan) position
+        template<typename graph_t, typename = void>
+        struct trace_names {
+            static constexpr auto make() { return node_names<graph_t>(); }
+        };
+
+        template<typename graph_t>
+        struct trace_names<graph_t, std::void_t<typename graph_t::plan_type>> {
+            template<typename... modules_t>
+            static constexpr auto make(type_list<modules_t...>) {
+                return std::array<std::string_view, sizeof...(modules_t)> { type_name<modules_t>()... };
+            }
+            static constexpr auto make() { return make(typename graph_t::plan_type::modules {}); }
+        };
+
+    } // namespace detail
+
+    // Records the node calls of a graph as Chrome trace events (chrome://tracing, ui.perfetto.dev).
+    // Every worker thread owns a single producer / single consumer ring of `capacity` events: the
+    // graph side never blocks nor allocates and drops the event when its ring is full, flush()
+    // drains all rings from any one other thread. Timestamps are clock_t ticks, written as
+    // microseconds by dividing by ticks_per_us (1000 for SteadyClock).
+    template<typename graph_t, std::size_t worker_count = 1, std::size_t capacity = 4096, typename clock_t = SteadyClock>
+    class ChromeTrace {
+
+        static_assert(worker_count > 0, "At least one worker is needed");
+        static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "Ring capacity must be a power of two");
+
+        struct event {
+            std::uint64_t start;
+            std::uint64_t end;
+            std::uint64_t frame;
+            std::size_t node;
+        };
+
+        struct ring {
+            alignas(cache_line_size) std::atomic<std::uint64_t> head { 0 };
+            alignas(cache_line_size) std::atomic<std::uint64_t> tail { 0 };
+            std::atomic<std::uint64_t> dropped { 0 };
+            std::array<event, capacity> events {};
+        };
+
+        static constexpr auto names = detail::trace_names<std::decay_t<graph_t>>::make();
+        static constexpr auto ids = std::decay_t<graph_t>::ids();
+
+        std::array<ring, worker_count> mRings {};
+        alignas(cache_line_size) std::atomic<std::uint64_t> mFrame { 0 };
+
+        template<typename stream_t>
+        static void write_name(stream_t& out, std::string_view name) {
+            for (const char c : name) {
+                if (c == '"' || c == '\\') {
+                    out << '\\';
+                }
+                out << c;
+            }
+        }
+
+        // Fixed point microseconds with up to 3 decimals: default stream formatting would print
+        // large timestamps (e.g. steady clock time since boot) in 6 significant digits
+        template<typename stream_t>
+        static void write_us(stream_t& out, std::uint64_t ticks, double ticks_per_us) {
+            const double us = static_cast<double>(ticks) / ticks_per_us;
+            std::uint64_t whole = static_cast<std::uint64_t>(us);
+            std::uint64_t thousandths = static_cast<std::uint64_t>((us - static_cast<double>(whole)) * 1000.0 + 0.5);
+            if (thousandths == 1000) {
+                ++whole;
+                thousandths = 0;
+            }
+            out << whole;
+            if (thousandths != 0) {
+                const char digits[] = { '.', char('0' + thousandths / 100), char('0' + thousandths / 10 % 10), char('0' + thousandths % 10) };
+                std::size_t length = 4;
+                while (digits[length - 1] == '0') {
+                    --length;
+                }
+                for (std::size_t i = 0; i < length; ++i) {
+                    out << digits[i];
+                }
+            }
+        }
+
+    public:
+
+        // for_each policy recording into the ring of one worker; use one per thread
+        class Worker {
+            ChromeTrace* mTrace;
+            std::size_t mIndex;
+        public:
+            constexpr Worker(ChromeTrace& trace, std::size_t index) : mTrace(&trace), mIndex(index) {}
+
+            std::size_t index() const { return mIndex; }
+
+            template<std::size_t node_index, typename F>
+            void invoke(F&& f) {
+                const std::uint64_t start = clock_t::now();
+                f();
+                mTrace->record(mIndex, node_index, start, clock_t::now());
+            }
+        };
+
+        static constexpr std::size_t size() { return names.size(); }
+
+        Worker worker(std::size_t index) { return Worker(*this, index); }
+
+        // Frame number stamped on the following events, usually bumped once per graph run
+        void next_frame() { mFrame.store(mFrame.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+        void set_frame(std::uint64_t frame) { mFrame.store(frame, std::memory_order_relaxed); }
+        std::uint64_t frame() const { return mFrame.load(std::memory_order_relaxed); }
+
+        void record(std::size_t worker_index, std::size_t node_index, std::uint64_t start, std::uint64_t end) {
+            ring& r = mRings[worker_index];
+            const std::uint64_t head = r.head.load(std::memory_order_relaxed);
+            if (head - r.tail.load(std::memory_order_acquire) == capacity) {
+                r.dropped.store(r.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            r.events[head & (capacity - 1)] = event { start, end, frame(), node_index };
+            r.head.store(head + 1, std::memory_order_release);
+        }
+
+        // Events lost to a full ring since construction
+        std::uint64_t dropped() const {
+            std::uint64_t n = 0;
+            for (const auto& r : mRings) {
+                n += r.dropped.load(std::memory_order_relaxed);
+            }
+            return n;
+        }
+
+        // Drains every ring into one Chrome trace JSON document, returns the number of node events
+        template<typename stream_t>
+        std::size_t flush(stream_t& out, double ticks_per_us = 1000.0) {
+            std::size_t count = 0;
+            out << "{\"traceEvents\":[";
+            for (std::size_t w = 0; w < worker_count; ++w) {
+                out << (w ? ",\n" : "\n");
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << w
+                    << ",\"args\":{\"name\":\"worker " << w << "\"}}";
+            }
+            for (std::size_t w = 0; w < worker_count; ++w) {
+                ring& r = mRings[w];
+                const std::uint64_t head = r.head.load(std::memory_order_acquire);
+                std::uint64_t tail = r.tail.load(std::memory_order_relaxed);
+                for (; tail != head; ++tail) {
+                    const event& e = r.events[tail & (capacity - 1)];
+                    out << ",\n{\"name\":\"";
+                    write_name(out, names[e.node]);
+                    out << " " << ids[e.node] << "\",\"cat\":\"node\",\"ph\":\"X\",\"pid\":0,\"tid\":" << w
+                        << ",\"ts\":";
+                    write_us(out, e.start, ticks_per_us);
+                    out << ",\"dur\":";
+                    write_us(out, e.end - e.start, ticks_per_us);
+                    out << ",\"args\":{\"id\":" << ids[e.node] << ",\"frame\":" << e.frame << "}}";
+                    ++count;
+                }
+                r.tail.store(tail, std::memory_order_release);
+            }
+            out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+            return count;
+        }
+    };
+
+} // namespace ugraph
@@ -0,0 +1,212 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License                                                                     *
+ *                                                                                 *
+ * Copyright (c) 2026 Thomas AUBERT                                                *
+ *                                                                                 *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy    *
+ * of this software and associated documentation files (the "Software"), to deal   *
+ * in the Software without restriction, including without limitation the rights    *
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       *
+ * copies of the Software, and to permit persons to whom the Software is           *
+ * furnished to do so, subject to the following conditions:                        *
+ *                                                                                 *
+ * The above copyright notice and this permission notice shall be included in all  *
+ * copies or substantial portions of the Software.                                 *
+ *                                                                                 *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     *
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   *
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   *
+ * SOFTWARE.                                                                       *
+ *                                                                                 *
+ * github : https://github.com/ThomasAUB/ugraph                                    *
+ *                                                                                 *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace ugraph::detail {
+
+    inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // std::swap is not constexpr before C++20
+    constexpr void swap_values(std::size_t& a, std::size_t& b) {
+        const std::size_t t = a;
+        a = b;
+        b = t;
+    }
+
+    // Sorted (key, value) pairs answering key lookups by binary search.
+    template<std::size_t N>
+    struct id_map {
+
+        std::array<std::size_t, N> keys {};
+        std::array<std::size_t, N> values {};
+
+        // Value stored for `key`, npos when absent
+        constexpr std::size_t find(std::size_t key) const {
+            std::size_t lo = 0;
+            std::size_t hi = N;
+            while (lo < hi) {
+                const std::size_t mid = lo + (hi - lo) / 2;
+                if (keys[mid] < key) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+            return (lo < N && keys[lo] == key) ? values[lo] : npos;
+        }
+
+        constexpr bool contains(std::size_t key) const { return find(key) != npos; }
+    };
+
+    // Heap sort of (key, value) pairs by key, O(N log N) constexpr steps
+    template<std::size_t N>
+    constexpr void sort_id_map(id_map<N>& m) {
+        auto sift = [&m] (std::size_t root, std::size_t end) {
+            while (2 * root + 1 < end) {
+                std::size_t child = 2 * root + 1;
+                if (child + 1 < end && m.keys[child] < m.keys[child + 1]) {
+                    ++child;
+                }
+                if (!(m.keys[root] < m.keys[child])) {
+                    return;
+                }
+                swap_values(m.keys[root], m.keys[child]);
+                swap_values(m.values[root], m.values[child]);
+                root = child;
+            }
+        };
+        for (std::size_t i = N / 2; i-- > 0;) {
+            sift(i, N);
+        }
+        for (std::size_t end = N; end-- > 1;) {
+            swap_values(m.keys[0], m.keys[end]);
+            swap_values(m.values[0], m.values[end]);
+            sift(0, end);
+        }
+    }
+
+    // Map each id of `ids` to its position in the array
+    template<std::size_t N>
+    constexpr id_map<N> make_id_map(const std::array<std::size_t, N>& ids) {
+        id_map<N> m {};
+        for (std::size_t i = 0; i < N; ++i) {
+            m.keys[i] = ids[i];
+            m.values[i] = i;
+        }
+        sort_id_map(m);
+        return m;
+    }
+
+    // Compressed sparse row adjacency of a graph with V vertices and up to E edges. Vertices are
+    // indexed by their position in the `ids` array the structure was built from; the successors of
+    // vertex i are targets[offsets[i]] .. targets[offsets[i + 1] - 1], in edge declaration order.
+    // Edges whose endpoints are not vertices are left out.
+    template<std::size_t V, std::size_t E>
+    struct adjacency {
+
+        std::array<std::size_t, V> ids {};
+        id_map<V> index {};
+        std::array<std::size_t, V + 1> offsets {};
+        std::array<std::size_t, E == 0 ? 1 : E> targets {};
+        std::array<std::size_t, V> in_degree {};
+
+        static constexpr std::size_t vertex_count() { return V; }
+        constexpr std::size_t edge_count() const { return offsets[V]; }
+
+        constexpr std::size_t index_of(std::size_t id) const { return index.find(id); }
+
+        constexpr std::size_t out_degree(std::size_t v) const { return offsets[v + 1] - offsets[v]; }
+    };
+
+    template<std::size_t V, std::size_t E>
+    constexpr adjacency<V, E> make_adjacency(
+        const std::array<std::size_t, V>& ids,
+        const std::array<std::pair<std::size_t, std::size_t>, E>& edges
+    ) {
+        adjacency<V, E> a {};
+        a.ids = ids;
+        a.index = make_id_map(ids);
+
+        std::array<std::size_t, E == 0 ? 1 : E> src {};
+        std::array<std::size_t, E == 0 ? 1 : E> dst {};
+        for (std::size_t e = 0; e < E; ++e) {
+            src[e] = a.index_of(edges[e].first);
+            dst[e] = a.index_of(edges[e].second);
+            if (src[e] != npos && dst[e] != npos) {
+                ++a.offsets[src[e] + 1];
+                ++a.in_degree[dst[e]];
+            }
+        }
+        for (std::size_t v = 0; v < V; ++v) {
+            a.offsets[v + 1] += a.offsets[v];
+        }
+        std::array<std::size_t, V + 1> fill = a.offsets;
+        for (std::size_t e = 0; e < E; ++e) {
+            if (src[e] != npos && dst[e] != npos) {
+                a.targets[fill[src[e]]++] = dst[e];
+            }
+        }
+        return a;
+    }
+
+    // Max-heap of vertex indices ordered by (priority, then lower index first), used as the
+    // ready queue of the priority-aware Kahn sort.
+    template<std::size_t V>
+    struct ready_queue {
+
+        std::array<std::size_t, V == 0 ? 1 : V> heap {};
+        std::size_t size = 0;
+
+        constexpr bool empty() const { return size == 0; }
+
+        template<typename priorities_t>
+        constexpr void push(std::size_t v, const priorities_t& prio) {
+            std::size_t i = size++;
+            heap[i] = v;
+            while (i > 0) {
+                const std::size_t parent = (i - 1) / 2;
+                if (!before(heap[i], heap[parent], prio)) {
+                    break;
+                }
+                swap_values(heap[i], heap[parent]);
+                i = parent;
+            }
+        }
+
+        template<typename priorities_t>
+        constexpr std::size_t pop(const priorities_t& prio) {
+            const std::size_t top = heap[0];
+            heap[0] = heap[--size];
+            std::size_t i = 0;
+            while (2 * i + 1 < size) {
+                std::size_t child = 2 * i + 1;
+                if (child + 1 < size && before(heap[child + 1], heap[child], prio)) {
+                    ++child;
+                }
+                if (!before(heap[child], heap[i], prio)) {
+                    break;
+                }
+                swap_values(heap[i], heap[child]);
+                i = child;
+            }
+            return top;
+        }
+
+    private:
+        template<typename priorities_t>
+        static constexpr bool before(std::size_t a, std::size_t b, const priorities_t& prio) {
+            return prio[a] > prio[b] || (prio[a] == prio[b] && a < b);
+        }
+    };
+
+} // namespace ugraph::detail
@@ -14,7 +14,10 @@ namespace ugraph::detail {
         static constexpr std::size_t port = Port;
     };
 
-    template<typename Topology, typename... edges_t>
+    // Slot assignment of one data type. Slots are reused between producers whose lifetimes do not
+    // overlap, lifetimes being measured in steps of the schedule: schedule_t::step(position, level)
+    // orders the nodes, nodes of one step may run at the same time and steps run one after the other.
+    template<typename Topology, typename schedule_t, typename... edges_t>
     class data_coloring {
         using topology_t = Topology;
 
@@ -39,9 +42,8 @@ namespace ugraph::detail {
         static constexpr std::size_t producer_count = detail::type_list_size<producer_list>::value;
 
         static constexpr std::size_t id_to_pos(std::size_t id) {
-            auto ids = topology_t::ids();
-            for (std::size_t i = 0; i < topology_t::size(); ++i) if (ids[i] == id) return i;
-            return static_cast<std::size_t>(-1);
+            const std::size_t pos = topology_t::position_of(id);
+            return pos == topology_t::size() ? static_cast<std::size_t>(-1) : pos;
         }
 
         template<std::size_t VID, std::size_t PORT, std::size_t I>
@@ -52,13 +54,20 @@ namespace ugraph::detail {
         template<std::size_t VID, std::size_t PORT>
         struct find_prod_index_impl<VID, PORT, producer_count> { static constexpr std::size_t value = static_cast<std::size_t>(-1); };
 
+        static constexpr std::size_t step_of(std::size_t pos) {
+            constexpr auto levels = topology_t::levels();
+            return schedule_t::step(pos, levels[pos]);
+        }
+
         struct lifetimes_t {
-            std::array<std::size_t, producer_count == 0 ? 1 : producer_count> start {}, end {};
+            std::array<std::size_t, producer_count == 0 ? 1 : producer_count> pos {}, start {}, end {};
         };
 
         template<std::size_t... I>
         static constexpr void init_lifetimes_indices(lifetimes_t& l, std::index_sequence<I...>) {
-            ((l.start[I] = id_to_pos(detail::type_list_at<I, producer_list>::type::vid), l.end[I] = l.start[I]), ...);
+            ((l.pos[I] = id_to_pos(detail::type_list_at<I, producer_list>::type::vid),
+              l.start[I] = step_of(l.pos[I]),
+              l.end[I] = l.start[I]), ...);
         }
 
         static constexpr lifetimes_t build_lifetimes() {
@@ -69,9 +78,9 @@ namespace ugraph::detail {
                 ([&] () {
                     using ET = edge_traits<edges_t>;
                     constexpr std::size_t idx = find_prod_index_impl<ET::src_id, ET::src_port_index, 0>::value;
-                    const std::size_t dpos = id_to_pos(ET::dst_id);
-                    if (dpos > lt.end[idx]) {
-                        lt.end[idx] = dpos;
+                    const std::size_t dstep = step_of(id_to_pos(ET::dst_id));
+                    if (dstep > lt.end[idx]) {
+                        lt.end[idx] = dstep;
                     }
                     }(), ...);
             }
@@ -135,7 +144,88 @@ namespace ugraph::detail {
             return a;
         }
 
-        static constexpr assignment_t assignment = build_assignment();
+        // Relabels slots so that the producers feeding the input ports of one node occupy
+        // consecutive slots in port order, which lets the consumer see its inputs as one array.
+        // Swapping two labels everywhere keeps the coloring valid; a group is only rearranged
+        // when this does not move the slots already given to an earlier group.
+        static constexpr assignment_t build_fan_in_assignment() {
+            assignment_t a = build_assignment();
+            if constexpr (sizeof...(edges_t) > 1) {
+                struct input_t { std::size_t pos; std::size_t port; std::size_t producer; };
+                std::array<input_t, sizeof...(edges_t)> ins {};
+                std::size_t n = 0;
+                ([&] () {
+                    using ET = edge_traits<edges_t>;
+                    ins[n++] = { id_to_pos(ET::dst_id), ET::dst_port_index, find_prod_index_impl<ET::src_id, ET::src_port_index, 0>::value };
+                    }(), ...);
+
+                std::array<bool, producer_count> fixed {};
+
+                for (std::size_t pos = 0; pos < topology_t::size(); ++pos) {
+                    std::array<std::size_t, sizeof...(edges_t)> group {};
+                    std::size_t k = 0;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        if (ins[i].pos == pos) {
+                            ++k;
+                        }
+                    }
+                    if (k < 2 || k > a.count) {
+                        continue;
+                    }
+                    // Ports 0..k-1 must all be fed, each by a distinct slot
+                    bool complete = true;
+                    for (std::size_t port = 0; port < k && complete; ++port) {
+                        std::size_t found = 0;
+                        for (std::size_t i = 0; i < n; ++i) {
+                            if (ins[i].pos == pos && ins[i].port == port) {
+                                group[port] = ins[i].producer;
+                                ++found;
+                            }
+                        }
+                        complete = found == 1;
+                        for (std::size_t q = 0; q < port && complete; ++q) {
+                            complete = a.buf[group[q]] != a.buf[group[port]];
+                        }
+                    }
+                    if (!complete) {
+                        continue;
+                    }
+                    for (std::size_t base = 0; base + k <= a.count; ++base) {
+                        assignment_t t = a;
+                        bool ok = true;
+                        for (std::size_t port = 0; port < k && ok; ++port) {
+                            const std::size_t from = t.buf[group[port]];
+                            const std::size_t to = base + port;
+                            if (from == to) {
+                                continue;
+                            }
+                            if (fixed[from] || fixed[to]) {
+                                ok = false;
+                                break;
+                            }
+                            for (std::size_t p = 0; p < producer_count; ++p) {
+                                if (t.buf[p] == from) {
+                                    t.buf[p] = to;
+                                }
+                                else if (t.buf[p] == to) {
+                                    t.buf[p] = from;
+                                }
+                            }
+                        }
+                        if (ok) {
+                            a = t;
+                            for (std::size_t port = 0; port < k; ++port) {
+                                fixed[base + port] = true;
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+            return a;
+        }
+
+        static constexpr assignment_t assignment = build_fan_in_assignment();
 
         template<std::size_t DVID, std::size_t DPORT, typename... Es>
         struct find_input_edge_impl;
@@ -175,6 +265,40 @@ namespace ugraph::detail {
     public:
         static constexpr std::size_t data_count() { return assignment.count; }
 
+        // True when two different nodes may access two distinct slots (or, with distinct == false,
+        // the same slot) at the same time, one of them writing, given the level of each vertex
+        // (indexed by topological position) and a schedule.
+        template<typename access_schedule_t, typename levels_t>
+        static constexpr bool has_concurrent_access(const levels_t& levels, bool distinct = true) {
+            if constexpr (producer_count == 0) {
+                return false;
+            }
+            else {
+                struct access_t { std::size_t slot; std::size_t pos; bool write; };
+                std::array<access_t, producer_count + sizeof...(edges_t)> acc {};
+                std::size_t n = 0;
+                for (std::size_t p = 0; p < producer_count; ++p) {
+                    acc[n++] = { assignment.buf[p], lifetimes.pos[p], true };
+                }
+                ([&] () {
+                    using ET = edge_traits<edges_t>;
+                    constexpr std::size_t idx = find_prod_index_impl<ET::src_id, ET::src_port_index, 0>::value;
+                    acc[n++] = { assignment.buf[idx], id_to_pos(ET::dst_id), false };
+                    }(), ...);
+                for (std::size_t i = 0; i < n; ++i) {
+                    for (std::size_t j = i + 1; j < n; ++j) {
+                        if ((acc[i].slot != acc[j].slot) == distinct &&
+                            acc[i].pos != acc[j].pos &&
+                            (acc[i].write || acc[j].write) &&
+                            access_schedule_t::concurrent(levels[acc[i].pos], levels[acc[j].pos])) {
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+        }
+
         template<std::size_t VID, std::size_t PORT>
         static constexpr std::size_t output_data_index() { return data_index_for_output<VID, PORT>(); }
 
@@ -182,26 +306,28 @@ namespace ugraph::detail {
         static constexpr std::size_t input_data_index() { return data_index_for_input<VID, PORT>(); }
     };
 
-    template<typename Topology, typename List>
+    template<typename Topology, typename schedule_t, typename List>
     struct coloring_from_list;
 
-    template<typename Topology, typename... Es>
-    struct coloring_from_list<Topology, detail::type_list<Es...>> {
-        using type = data_coloring<Topology, Es...>;
+    template<typename Topology, typename schedule_t, typename... Es>
+    struct coloring_from_list<Topology, schedule_t, detail::type_list<Es...>> {
+        using type = data_coloring<Topology, schedule_t, Es...>;
     };
 
     struct empty_coloring {
         static constexpr std::size_t data_count() { return 0; }
+        template<typename, typename levels_t>
+        static constexpr bool has_concurrent_access(const levels_t&, bool = true) { return false; }
         template<std::size_t, std::size_t>
         static constexpr std::size_t input_data_index() { return static_cast<std::size_t>(-1); }
         template<std::size_t, std::size_t>
         static constexpr std::size_t output_data_index() { return static_cast<std::size_t>(-1); }
     };
 
-    template<typename Topology, typename List>
-    struct coloring_or_empty { using type = typename coloring_from_list<Topology, List>::type; };
+    template<typename Topology, typename schedule_t, typename List>
+    struct coloring_or_empty { using type = typename coloring_from_list<Topology, schedule_t, List>::type; };
 
-    template<typename Topology>
-    struct coloring_or_empty<Topology, detail::type_list<>> { using type = empty_coloring; };
+    template<typename Topology, typename schedule_t>
+    struct coloring_or_empty<Topology, schedule_t, detail::type_list<>> { using type = empty_coloring; };
 
 } // namespace ugraph::detail
@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include "graph_coloring.hpp"
+#include "../storage.hpp"
 
 namespace ugraph::detail {
 
@@ -134,30 +135,13 @@ namespace ugraph::detail {
             using node_type = shifted_vertex<V, Base>;
         };
 
+        // Boundary sets are cached by the nested module's Topology, see Topology::entry_ids()
         template<typename M, typename = void>
         struct module_entry_count { static constexpr std::size_t value = 1; };
 
         template<typename M>
         struct module_entry_count<M, std::enable_if_t<has_nested_graph_interface<M>::value>> {
-            static constexpr std::size_t compute() {
-                constexpr auto ids = M::topology_type::ids();
-                constexpr auto edges = M::topology_type::edges();
-                std::size_t c = 0;
-                for (std::size_t i = 0; i < ids.size(); ++i) {
-                    bool has_in = false;
-                    for (std::size_t j = 0; j < edges.size(); ++j) {
-                        if (edges[j].second == ids[i]) {
-                            has_in = true;
-                            break;
-                        }
-                    }
-                    if (!has_in) {
-                        ++c;
-                    }
-                }
-                return c;
-            }
-            static constexpr std::size_t value = compute();
+            static constexpr std::size_t value = M::topology_type::entry_ids().size();
         };
 
         template<typename M, typename = void>
@@ -165,72 +149,14 @@ namespace ugraph::detail {
 
         template<typename M>
         struct module_exit_count<M, std::enable_if_t<has_nested_graph_interface<M>::value>> {
-            static constexpr std::size_t compute() {
-                constexpr auto ids = M::topology_type::ids();
-                constexpr auto edges = M::topology_type::edges();
-                std::size_t c = 0;
-                for (std::size_t i = 0; i < ids.size(); ++i) {
-                    bool has_out = false;
-                    for (std::size_t j = 0; j < edges.size(); ++j) {
-                        if (edges[j].first == ids[i]) {
-                            has_out = true;
-                            break;
-                        }
-                    }
-                    if (!has_out) {
-                        ++c;
-                    }
-                }
-                return c;
-            }
-            static constexpr std::size_t value = compute();
+            static constexpr std::size_t value = M::topology_type::exit_ids().size();
         };
 
         template<typename M, std::size_t K>
-        static constexpr std::size_t module_entry_id_at() {
-            constexpr auto ids = M::topology_type::ids();
-            constexpr auto edges = M::topology_type::edges();
-            std::size_t found = 0;
-            for (std::size_t i = 0; i < ids.size(); ++i) {
-                bool has_in = false;
-                for (std::size_t j = 0; j < edges.size(); ++j) {
-                    if (edges[j].second == ids[i]) {
-                        has_in = true;
-                        break;
-                    }
-                }
-                if (!has_in) {
-                    if (found == K) {
-                        return ids[i];
-                    }
-                    ++found;
-                }
-            }
-            return static_cast<std::size_t>(0);
-        }
+        static constexpr std::size_t module_entry_id_at() { return M::topology_type::entry_ids()[K]; }
 
         template<typename M, std::size_t K>
-        static constexpr std::size_t module_exit_id_at() {
-            constexpr auto ids = M::topology_type::ids();
-            constexpr auto edges = M::topology_type::edges();
-            std::size_t found = 0;
-            for (std::size_t i = 0; i < ids.size(); ++i) {
-                bool has_out = false;
-                for (std::size_t j = 0; j < edges.size(); ++j) {
-                    if (edges[j].first == ids[i]) {
-                        has_out = true;
-                        break;
-                    }
-                }
-                if (!has_out) {
-                    if (found == K) {
-                        return ids[i];
-                    }
-                    ++found;
-                }
-            }
-            return static_cast<std::size_t>(0);
-        }
+        static constexpr std::size_t module_exit_id_at() { return M::topology_type::exit_ids()[K]; }
 
         template<typename M, std::size_t K, std::size_t Base>
         using module_entry_vertex_t = shifted_vertex<
@@ -415,6 +341,14 @@ namespace ugraph::detail {
 
         using modules_tuple_t = decltype(make_modules_tuple_t(std::make_index_sequence<topology_t::size()>{}));
 
+        template<template<typename...> class store_t, std::size_t... I>
+        static constexpr auto make_modules_store_t(std::index_sequence<I...>) ->
+            store_t<typename node_type_at<I>::module_type...>;
+
+        // Module storage (ModuleRefs, ModuleStore) holding the modules in topological order
+        template<template<typename...> class store_t>
+        using modules_store_t = decltype(make_modules_store_t<store_t>(std::make_index_sequence<topology_t::size()>{}));
+
         template<std::size_t id, typename Edge>
         static constexpr auto try_edge_module(const Edge& e) {
             using S = typename detail::edge_traits<Edge>::src_vertex_t;
@@ -481,8 +415,24 @@ namespace ugraph::detail {
         template<typename T>
         using edge_list_for_t = typename detail::filter_edges<T, flattened_edges_t>::type;
 
-        template<typename T>
-        using coloring_t = typename detail::coloring_or_empty<topology_t, edge_list_for_t<T>>::type;
+        template<typename T, typename schedule_t = SerialSchedule>
+        using coloring_t = typename detail::coloring_or_empty<topology_t, schedule_t, edge_list_for_t<T>>::type;
+
+        // Slots of T get a cache line each only if the schedule lets different cores touch them at once.
+        template<typename T, typename schedule_t>
+        static constexpr bool padded_slots() {
+            return alignof(T) < cache_line_size &&
+                coloring_t<T, schedule_t>::template has_concurrent_access<schedule_t>(topology_t::levels());
+        }
+
+        // A slot written by a node while another node may access it at the same time
+        template<typename T, typename schedule_t>
+        static constexpr bool shares_concurrent_slots() {
+            return coloring_t<T, schedule_t>::template has_concurrent_access<schedule_t>(topology_t::levels(), false);
+        }
+
+        template<typename T, typename schedule_t>
+        using slot_t = std::conditional_t<padded_slots<T, schedule_t>(), PaddedSlot<T>, T>;
 
         template<typename T, std::size_t VID, std::size_t PORT, typename EdgeList>
         struct has_input_edge_impl;
@@ -522,22 +472,22 @@ namespace ugraph::detail {
             return has_output_edge_impl<T, VID, PORT, flattened_edges_t>::value;
         }
 
-        template<typename T, std::size_t NodeIndex, std::size_t PortIndex>
+        template<typename T, std::size_t NodeIndex, std::size_t PortIndex, typename schedule_t = SerialSchedule>
         static constexpr std::size_t input_index_for() {
             constexpr std::size_t vid = topology_t::template id_at<NodeIndex>();
             if constexpr (has_input_edge<T, vid, PortIndex>()) {
-                return coloring_t<T>::template input_data_index<vid, PortIndex>();
+                return coloring_t<T, schedule_t>::template input_data_index<vid, PortIndex>();
             }
             else {
                 return invalid_index;
             }
         }
 
-        template<typename T, std::size_t NodeIndex, std::size_t PortIndex>
+        template<typename T, std::size_t NodeIndex, std::size_t PortIndex, typename schedule_t = SerialSchedule>
         static constexpr std::size_t output_index_for() {
             constexpr std::size_t vid = topology_t::template id_at<NodeIndex>();
             if constexpr (has_output_edge<T, vid, PortIndex>()) {
-                return coloring_t<T>::template output_data_index<vid, PortIndex>();
+                return coloring_t<T, schedule_t>::template output_data_index<vid, PortIndex>();
             }
             else {
                 return invalid_index;
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
 #include <type_traits>
 
 namespace ugraph::detail {
@@ -38,11 +39,43 @@ namespace ugraph::detail {
     template<std::size_t N, typename List>
     struct type_list_at; // primary template
 
-    template<std::size_t N, typename T, typename... Ts>
-    struct type_list_at<N, type_list<T, Ts...>> : type_list_at<N - 1, type_list<Ts...>> {};
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define UGRAPH_HAS_TYPE_PACK_ELEMENT 1
+#endif
+#endif
 
-    template<typename T, typename... Ts>
-    struct type_list_at<0, type_list<T, Ts...>> { using type = T; };
+#if defined(UGRAPH_HAS_TYPE_PACK_ELEMENT)
+
+    template<std::size_t N, typename... Ts>
+    struct type_list_at<N, type_list<Ts...>> {
+        static_assert(N < sizeof...(Ts), "type_list index out of range");
+        using type = __type_pack_element<N, Ts...>;
+    };
+
+#else
+
+    // Constant depth lookup: every element becomes a base tagged with its index, and overload
+    // resolution picks the base matching N. The base set is instantiated once per list.
+    template<std::size_t I, typename T>
+    struct indexed_type { using type = T; };
+
+    template<typename Seq, typename... Ts>
+    struct indexed_types;
+
+    template<std::size_t... I, typename... Ts>
+    struct indexed_types<std::index_sequence<I...>, Ts...> : indexed_type<I, Ts>... {};
+
+    template<std::size_t N, typename T>
+    indexed_type<N, T> select_indexed(const indexed_type<N, T>&);
+
+    template<std::size_t N, typename... Ts>
+    struct type_list_at<N, type_list<Ts...>> {
+        static_assert(N < sizeof...(Ts), "type_list index out of range");
+        using type = typename decltype(select_indexed<N>(std::declval<const indexed_types<std::index_sequence_for<Ts...>, Ts...>&>()))::type;
+    };
+
+#endif
 
     template<typename List>
     struct type_list_size;
@@ -53,16 +86,19 @@ namespace ugraph::detail {
     template<typename T, typename List>
     struct type_list_index;
 
+    // Position of the first T in the list, computed in a single constexpr pass
     template<typename T, typename... Ts>
-    struct type_list_index<T, type_list<T, Ts...>> : std::integral_constant<std::size_t, 0> {};
-
-    template<typename T, typename U, typename... Ts>
-    struct type_list_index<T, type_list<U, Ts...>>
-        : std::integral_constant<std::size_t, 1 + type_list_index<T, type_list<Ts...>>::value> {};
-
-    template<typename T>
-    struct type_list_index<T, type_list<>> {
-        static_assert(!std::is_same_v<T, T>, "Type not found in type_list");
+    struct type_list_index<T, type_list<Ts...>> {
+        static constexpr std::size_t find() {
+            constexpr bool same[] = { std::is_same_v<T, Ts>..., false };
+            std::size_t i = 0;
+            while (i < sizeof...(Ts) && !same[i]) {
+                ++i;
+            }
+            return i;
+        }
+        static_assert(find() < sizeof...(Ts), "Type not found in type_list");
+        static constexpr std::size_t value = find();
     };
 
     template<typename T, typename List>
@@ -0,0 +1,122 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <memory>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <csignal>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// The counting operators of the whole test program
+UGRAPH_DEFINE_ALLOCATION_HOOKS;
+
+// Tests for AllocationGuard: heap use inside node calls is attributed to the node.
+namespace {
+
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) { ctx.template output<int>() = 1; }
+    };
+
+    // Keeps a growing history: allocates whenever the vector runs out of capacity
+    struct History {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        std::vector<int> values;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            values.push_back(ctx.template input<int>());
+            ctx.template output<int>() = static_cast<int>(values.size());
+        }
+    };
+
+    struct Scratch {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 0> >;
+        template<typename context_t>
+        void process(context_t&) { auto p = std::make_unique<int>(0); (void) p; }
+    };
+
+    const auto process = [] (auto& m, auto& ctx) { m.process(ctx); };
+
+}
+
+TEST_CASE("allocation guard attributes heap use to nodes") {
+
+    REQUIRE(ugraph::allocation_hooks_installed());
+
+    Source src;
+    History history;
+    Scratch scratch;
+    auto nSrc = ugraph::make_node<1>(src);
+    auto nHistory = ugraph::make_node<2>(history);
+    auto nScratch = ugraph::make_node<3>(scratch);
+    auto g = ugraph::StaticGraph(nSrc.output<int>() >> nHistory.input<int>(), nHistory.output<int>() >> nScratch.input<int>());
+
+    ugraph::AllocationGuard<decltype(g)::size()> guard;
+    g.for_each(guard, process);
+
+    CHECK(guard.violations() == 2);
+    CHECK(guard.allocations(g.position_of(1)) == 0);
+    CHECK(guard.allocations(g.position_of(2)) == 1);
+    CHECK(guard.allocations(g.position_of(3)) == 1);
+    CHECK(guard.deallocations(g.position_of(3)) == 1);
+
+    // Reserving up front keeps the history node off the heap
+    guard.reset();
+    history.values.reserve(16);
+    g.for_each(guard, process);
+    CHECK(guard.allocations(g.position_of(2)) == 0);
+    CHECK(guard.violations() == 1);
+}
+
+TEST_CASE("allocation guard ignores allocations outside node calls") {
+
+    Source src;
+    History history;
+    history.values.reserve(4);
+    auto nSrc = ugraph::make_node<1>(src);
+    auto nHistory = ugraph::make_node<2>(history);
+    auto g = ugraph::Graph(nSrc.output<int>() >> nHistory.input<int>());
+    decltype(g)::graph_data_t dg;
+    g.init_graph_data(dg);
+    int out = 0;
+    g.bind_output<2>(out);
+
+    ugraph::AllocationGuard<decltype(g)::size()> guard(true);
+    auto unrelated = std::make_unique<int>(1);
+    g.for_each(guard, process);
+    CHECK(guard.clean());
+    CHECK(out == 1);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("allocation guard can abort on the first violation") {
+
+    const pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        // Only the parent reports: drop doctest's crash handler and the child's output
+        std::signal(SIGABRT, SIG_DFL);
+        const int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            dup2(null_fd, STDOUT_FILENO);
+            dup2(null_fd, STDERR_FILENO);
+        }
+        Source src;
+        Scratch scratch;
+        auto nSrc = ugraph::make_node<1>(src);
+        auto nScratch = ugraph::make_node<2>(scratch);
+        auto g = ugraph::StaticGraph(nSrc.output<int>() >> nScratch.input<int>());
+        ugraph::AllocationGuard<decltype(g)::size()> guard(true);
+        g.for_each(guard, process);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    CHECK(WIFSIGNALED(status));
+    CHECK(WTERMSIG(status) == SIGABRT);
+}
+#endif
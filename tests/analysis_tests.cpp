@@ -0,0 +1,88 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <array>
+
+// Tests for analyze_parallelism: work, span, critical path and level widths.
+namespace {
+
+    struct Cheap { static constexpr int cost = 1; };
+    struct Costly { static constexpr int cost = 10; };
+    struct Plain {};
+
+    // 1 -> {2, 3, 4} -> 5, with 3 the expensive branch
+    using a = ugraph::NodeTag<1, Cheap>;
+    using b = ugraph::NodeTag<2, Cheap>;
+    using c = ugraph::NodeTag<3, Costly>;
+    using d = ugraph::NodeTag<4, Plain>;
+    using e = ugraph::NodeTag<5, Cheap>;
+
+    using diamond_t = ugraph::Topology<
+        std::pair<a, b>, std::pair<a, c>, std::pair<a, d>,
+        std::pair<b, e>, std::pair<c, e>, std::pair<d, e>
+    >;
+
+}
+
+TEST_CASE("static costs are analysed at compile time") {
+
+    constexpr auto r = ugraph::analyze_parallelism<diamond_t>();
+
+    static_assert(r.work == 14.0);
+    static_assert(r.span == 12.0);
+    static_assert(r.critical_length == 3);
+    static_assert(r.critical_path[0] == 1 && r.critical_path[1] == 3 && r.critical_path[2] == 5);
+    static_assert(r.on_critical_path(3) && !r.on_critical_path(2));
+    static_assert(r.level_count == 3);
+    static_assert(r.level_width[0] == 1 && r.level_width[1] == 3 && r.level_width[2] == 1);
+    static_assert(r.max_width == 3);
+
+    CHECK(r.parallelism() == doctest::Approx(14.0 / 12.0));
+    CHECK(r.speedup(1) == doctest::Approx(1.0));
+    CHECK(r.speedup(4) == doctest::Approx(14.0 / 12.0));
+}
+
+TEST_CASE("measured costs change the critical path") {
+
+    constexpr auto pos = [] (std::size_t id) { return diamond_t::position_of(id); };
+
+    std::array<double, 5> costs {};
+    costs[pos(1)] = 2;
+    costs[pos(2)] = 8;
+    costs[pos(3)] = 1;
+    costs[pos(4)] = 1;
+    costs[pos(5)] = 2;
+
+    const auto r = ugraph::analyze_parallelism<diamond_t>(costs);
+    CHECK(r.work == 14.0);
+    CHECK(r.span == 12.0);
+    REQUIRE(r.critical_length == 3);
+    CHECK(r.critical_path[1] == 2);
+
+    // Enough work spread over independent chains to keep several cores busy
+    std::array<double, 5> even { 1, 1, 1, 1, 1 };
+    const auto flat = ugraph::analyze_parallelism<diamond_t>(even);
+    CHECK(flat.span == 3.0);
+    CHECK(flat.speedup(2) == doctest::Approx(5.0 / 3.0));
+}
+
+TEST_CASE("graphs are analysed through their topology") {
+
+    struct Stage {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+    };
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, 2> >;
+    };
+
+    Source s;
+    Stage x, y;
+    auto nS = ugraph::make_node<1>(s);
+    auto nX = ugraph::make_node<2>(x);
+    auto nY = ugraph::make_node<3>(y);
+    auto g = ugraph::StaticGraph(nS.output<int, 0>() >> nX.input<int>(), nS.output<int, 1>() >> nY.input<int>());
+
+    constexpr auto r = ugraph::analyze_parallelism<decltype(g)>();
+    static_assert(r.work == 3.0);
+    static_assert(r.span == 2.0);
+    static_assert(r.max_width == 2);
+}
@@ -38,9 +38,10 @@ namespace {
 
         float value { 0.f };
 
-        void process(ugraph::Context<Manifest>& ctx) {
-            auto frequency = ctx.input<Parameters>().getFreq();
-            process(ctx.output<AudioBuffer>().mData, ctx.output<AudioBuffer>().mSize);
+        template<typename context_t>
+        void process(context_t& ctx) {
+            auto frequency = ctx.template input<Parameters>().getFreq();
+            process(ctx.template output<AudioBuffer>().mData, ctx.template output<AudioBuffer>().mSize);
         }
 
         // Pointer-based helper for manual path in tests
@@ -55,12 +56,13 @@ namespace {
 
         using Manifest = ugraph::Manifest< ugraph::IO<AudioBuffer, 2, 1> >;
 
-        void process(ugraph::Context<Manifest>& ctx) {
+        template<typename context_t>
+        void process(context_t& ctx) {
             process(
-                ctx.input<AudioBuffer>(0).mData,
-                ctx.input<AudioBuffer>(1).mData,
-                ctx.output<AudioBuffer>().mData,
-                ctx.output<AudioBuffer>().mSize
+                ctx.template input<AudioBuffer>(0).mData,
+                ctx.template input<AudioBuffer>(1).mData,
+                ctx.template output<AudioBuffer>().mData,
+                ctx.template output<AudioBuffer>().mSize
             );
         }
 
@@ -80,8 +82,9 @@ namespace {
 
         float gain { 1.f };
 
-        void process(ugraph::Context<Manifest>& ctx) {
-            process(ctx.input<AudioBuffer>().mData, ctx.output<AudioBuffer>().mData, ctx.output<AudioBuffer>().mSize);
+        template<typename context_t>
+        void process(context_t& ctx) {
+            process(ctx.template input<AudioBuffer>().mData, ctx.template output<AudioBuffer>().mData, ctx.template output<AudioBuffer>().mSize);
         }
 
         // Pointer-based helper for manual path in tests
@@ -101,8 +104,9 @@ namespace {
         float last_sample { 0.f };
         float sum { 0.f };
 
-        void process(ugraph::Context<Manifest>& ctx) {
-            process(ctx.input<AudioBuffer>().mData, ctx.input<AudioBuffer>().mSize);
+        template<typename context_t>
+        void process(context_t& ctx) {
+            process(ctx.template input<AudioBuffer>().mData, ctx.template input<AudioBuffer>().mSize);
         }
 
         // Pointer-based helper for manual path in tests
@@ -440,4 +444,69 @@ TEST_CASE("audio graph pipeline vs manual performance ratio") {
     (void) consume; // silence unused warning for volatile accumulation
 }
 
+TEST_CASE("audio graph static binding matches the manual path") {
+    ConstantSource sa { 0.3f };
+    ConstantSource sb { 0.4f };
+    Mixer2        mix {};
+    Gain          gain { 1.25f };
+    Sink          sinkPipe {};
+    Sink          sinkManual {};
+
+    auto vA = ugraph::make_node<6001>(sa);
+    auto vB = ugraph::make_node<6002>(sb);
+    auto vMix = ugraph::make_node<6003>(mix);
+    auto vGain = ugraph::make_node<6004>(gain);
+    auto vSink = ugraph::make_node<6005>(sinkPipe);
+
+    // Ports resolve to slot indices at compile time: no init_graph_data, no binding
+    auto g = ugraph::StaticGraph(
+        vA.output<AudioBuffer>() >> vMix.input<AudioBuffer, 0>(),
+        vB.output<AudioBuffer>() >> vMix.input<AudioBuffer, 1>(),
+        vMix.output<AudioBuffer>() >> vGain.input<AudioBuffer>(),
+        vGain.output<AudioBuffer>() >> vSink.input<AudioBuffer>()
+    );
+
+    constexpr std::size_t kBlockSize = 64;
+
+    using storage_t = std::array<float, kBlockSize>;
+    std::array<storage_t, 3> storage;
+
+    static constexpr auto graph_storage_count = decltype(g)::slot_count<AudioBuffer>();
+    CHECK(graph_storage_count == 3);
+
+    std::array<storage_t, graph_storage_count> gstorage;
+    for (std::size_t i = 0; i < graph_storage_count; ++i) {
+        g.data_at<AudioBuffer>(i) = gstorage[i];
+    }
+
+    // Same buffer reuse as the manual path: both sources live until the mixer, which cannot write
+    // over its own inputs, the gain output takes a freed slot
+    using G = decltype(g);
+    static_assert(G::data_count<AudioBuffer>() == 3);
+    constexpr auto slotA = G::output_slot<AudioBuffer, 6001, 0>();
+    constexpr auto slotB = G::output_slot<AudioBuffer, 6002, 0>();
+    constexpr auto slotMix = G::output_slot<AudioBuffer, 6003, 0>();
+    constexpr auto slotGain = G::output_slot<AudioBuffer, 6004, 0>();
+    static_assert(slotA != slotB && slotMix != slotA && slotMix != slotB && slotGain != slotMix);
+    static_assert(slotGain < graph_storage_count);
+
+    g.for_each(
+        [] (auto& module, auto& ctx) {
+            module.process(ctx);
+        }
+    );
+
+    sa.process(storage[0].data(), kBlockSize);
+    sb.process(storage[1].data(), kBlockSize);
+    mix.process(storage[0].data(), storage[1].data(), storage[2].data(), kBlockSize);
+    gain.process(storage[2].data(), storage[0].data(), kBlockSize);
+    sinkManual.process(storage[0].data(), kBlockSize);
+
+    CHECK(sinkPipe.last_sample == doctest::Approx(0.875f));
+    CHECK(sinkPipe.sum == doctest::Approx(0.875f * kBlockSize));
+    CHECK(sinkPipe.last_sample == sinkManual.last_sample);
+    CHECK(sinkPipe.sum == sinkManual.sum);
+    CHECK(g.data_at<AudioBuffer>(slotGain).mData[kBlockSize - 1] == storage[0][kBlockSize - 1]);
+}
+
 #endif // __clang__
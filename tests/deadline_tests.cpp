@@ -0,0 +1,106 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <cstdint>
+
+// Tests for DeadlineMonitor and its latency histogram.
+namespace {
+
+    // Time only moves when a node says so
+    struct FakeClock {
+        static inline std::uint64_t time = 0;
+        static std::uint64_t now() { return time; }
+    };
+
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, 1> >;
+        std::uint64_t cost = 0;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            FakeClock::time += cost;
+            ctx.template output<int>() = 1;
+        }
+    };
+
+    struct Sink {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 0> >;
+        std::uint64_t cost = 0;
+        template<typename context_t>
+        void process(context_t&) { FakeClock::time += cost; }
+    };
+
+}
+
+TEST_CASE("latency histogram buckets are log-linear") {
+
+    using histogram_t = ugraph::LatencyHistogram<3>;
+
+    static_assert(histogram_t::bucket_of(0) == 0);
+    static_assert(histogram_t::bucket_of(7) == 7);
+    static_assert(histogram_t::bucket_of(15) == 15);
+    static_assert(histogram_t::bucket_of(16) == 16 && histogram_t::bucket_of(17) == 16);
+    static_assert(histogram_t::upper_bound(16) == 17);
+    static_assert(histogram_t::bucket_of(~std::uint64_t(0)) == histogram_t::bucket_count - 1);
+
+    // Every bucket upper bound lands in its own bucket, within 1/8 of the bucket lower bound
+    for (std::size_t b = 1; b + 1 < histogram_t::bucket_count; ++b) {
+        const auto hi = histogram_t::upper_bound(b);
+        CHECK(histogram_t::bucket_of(hi) == b);
+        CHECK(histogram_t::bucket_of(hi + 1) == b + 1);
+    }
+
+    histogram_t h;
+    for (std::uint64_t v = 1; v <= 100; ++v) {
+        h.record(v * 1000);
+    }
+    const auto median = h.quantile(0.5);
+    CHECK(median >= 50000);
+    CHECK(median <= 50000 + 50000 / 8);
+    CHECK(h.quantile(1.0) >= 100000);
+}
+
+TEST_CASE("deadline monitor counts misses and the slowest node of missed blocks") {
+
+    Source src;
+    Sink sink;
+    auto nSrc = ugraph::make_node<1>(src);
+    auto nSink = ugraph::make_node<2>(sink);
+    auto g = ugraph::StaticGraph(nSrc.output<int>() >> nSink.input<int>());
+    const auto process = [] (auto& m, auto& ctx) { m.process(ctx); };
+
+    // 64 frames at 48 kHz: 1333333 ns
+    ugraph::DeadlineMonitor<decltype(g)::size(), FakeClock, 2> monitor(48000.0);
+
+    src.cost = 100000;
+    sink.cost = 200000;
+    CHECK(monitor.run(g, 64, process));
+
+    sink.cost = 2000000;
+    CHECK_FALSE(monitor.run(g, 64, process));
+
+    src.cost = 3000000;
+    CHECK_FALSE(monitor.run(g, 64, process));
+    CHECK_FALSE(monitor.run(g, 64, process));
+
+    // A larger block has a larger budget
+    CHECK(monitor.run(g, 4096, process));
+
+    CHECK(monitor.frames() == 5);
+    CHECK(monitor.misses() == 3);
+    CHECK(monitor.worst() == 5000000);
+    CHECK(monitor.missed_as_slowest(g.position_of(2)) == 1);
+    CHECK(monitor.missed_as_slowest(g.position_of(1)) == 2);
+    CHECK(monitor.histogram().quantile(0.0) >= 300000);
+
+    // Two misses fit in the ring; the third was only counted
+    ugraph::DeadlineMiss miss;
+    REQUIRE(monitor.pop_miss(miss));
+    CHECK(miss.frame == 1);
+    CHECK(miss.elapsed == 2100000);
+    CHECK(miss.budget == 1333333);
+    CHECK(miss.slowest_node == g.position_of(2));
+    CHECK(miss.slowest_ticks == 2000000);
+    REQUIRE(monitor.pop_miss(miss));
+    CHECK(miss.frame == 2);
+    CHECK(miss.slowest_node == g.position_of(1));
+    CHECK_FALSE(monitor.pop_miss(miss));
+}
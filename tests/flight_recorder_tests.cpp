@@ -0,0 +1,149 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include "osc_gain_graph.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+
+// Tests for FlightRecorder: the last frames of a graph kept in a ring and dumped on request.
+namespace {
+
+    // Every read advances the clock by 10 ticks
+    struct FakeClock {
+        static inline std::uint64_t time = 0;
+        static std::uint64_t now() {
+            const std::uint64_t t = time;
+            time += 10;
+            return t;
+        }
+    };
+
+    using namespace osc_gain_test;
+
+    // Runs `hook` once, on the first write
+    struct HookedBuffer : std::stringbuf {
+        std::function<void()> hook;
+        std::streamsize xsputn(const char* s, std::streamsize n) override {
+            if (hook) {
+                auto h = std::move(hook);
+                hook = nullptr;
+                h();
+            }
+            return std::stringbuf::xsputn(s, n);
+        }
+    };
+
+}
+
+TEST_CASE("flight recorder keeps the last frames and their node timings") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    ugraph::FlightRecorder<graph_t, 4, ugraph::NoSnapshot, FakeClock> recorder;
+    for (int i = 0; i < 6; ++i) {
+        CHECK(recorder.run(g, process));
+    }
+    CHECK_FALSE(recorder.dump_requested());
+
+    std::ostringstream out;
+    CHECK(recorder.dump(out) == 4);
+    const std::string s = out.str();
+    CHECK(s.find("4 frames, 2 nodes") != s.npos);
+    CHECK(s.find("frame 1 ") == s.npos);
+    CHECK(s.find("frame 2 ") != s.npos);
+    CHECK(s.find("frame 5 ") != s.npos);
+    // begin, then a start / end read per node, then end: 50 ticks per frame
+    CHECK(occurrences(s, "duration 50\n") == 4);
+    CHECK(occurrences(s, "Osc 1 start 10 duration 10") == 4);
+    CHECK(occurrences(s, "Gain 2 start 30 duration 10") == 4);
+}
+
+TEST_CASE("flight recorder requests a dump on overrun and on trigger") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    ugraph::FlightRecorder<graph_t, 8, graph_t::graph_data_t, FakeClock> recorder;
+    recorder.set_budget(100);
+
+    CHECK(recorder.run(g, process, g.graph_data()));
+    CHECK_FALSE(recorder.dump_requested());
+
+    // A slow node makes the frame overrun the budget
+    recorder.begin_frame();
+    g.for_each(recorder, [] (auto& m, auto& ctx) {
+        FakeClock::time += 200;
+        m.process(ctx);
+    });
+    CHECK_FALSE(recorder.end_frame(g.graph_data()));
+    CHECK(recorder.overruns() == 1);
+    REQUIRE(recorder.dump_requested());
+
+    std::ostringstream out;
+    CHECK(recorder.dump(out) == 2);
+    CHECK_FALSE(recorder.dump_requested());
+    CHECK(occurrences(out.str(), " overrun\n") == 1);
+    // Slot snapshot: the float slots hold the gain input and output
+    CHECK(occurrences(out.str(), "  slots 1 0.5\n") == 2);
+
+    recorder.trigger();
+    CHECK(recorder.dump_requested());
+}
+
+TEST_CASE("flight recorder writer dumps to a file from its own thread") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    using recorder_t = ugraph::FlightRecorder<graph_t, 16>;
+    recorder_t recorder;
+    const std::string prefix = "ugraph_flight_recorder_test_";
+    {
+        ugraph::FlightRecorderWriter<recorder_t> writer(recorder, prefix, std::chrono::milliseconds(1));
+        for (int i = 0; i < 100; ++i) {
+            recorder.run(g, process);
+        }
+        recorder.trigger();
+        for (int i = 0; i < 100; ++i) {
+            recorder.run(g, process);
+        }
+    }
+
+    std::ifstream file(prefix + "0.txt");
+    REQUIRE(file.good());
+    std::stringstream content;
+    content << file.rdbuf();
+    CHECK(content.str().find("# ugraph flight recorder: 16 frames") == 0);
+    file.close();
+    std::remove((prefix + "0.txt").c_str());
+}
+
+TEST_CASE("flight recorder records frames while a dump is being written") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    ugraph::FlightRecorder<graph_t, 4, ugraph::NoSnapshot, FakeClock> recorder;
+    recorder.run(g, process);
+    recorder.run(g, process);
+
+    HookedBuffer buffer;
+    buffer.hook = [&] { recorder.run(g, process); };
+    std::ostream out(&buffer);
+    CHECK(recorder.dump(out) == 2);
+    CHECK(recorder.skipped() == 0);
+    CHECK(buffer.str().find("frame 2 ") == std::string::npos);
+
+    std::ostringstream again;
+    CHECK(recorder.dump(again) == 3);
+    CHECK(again.str().find("frame 2 ") != std::string::npos);
+}
@@ -0,0 +1,130 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+
+// Tests for fan-in slot placement: producers of one multi-input node are colored into consecutive slots.
+namespace {
+
+    struct Value {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, 1> >;
+        int value = 0;
+        template<typename context_t>
+        constexpr void process(context_t& ctx) { ctx.template output<int>() = value; }
+    };
+
+    struct Double {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        template<typename context_t>
+        constexpr void process(context_t& ctx) { ctx.template output<int>() = 2 * ctx.template input<int>(); }
+    };
+
+    template<std::size_t N>
+    struct Sum {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, N, 0> >;
+        int result = 0;
+        bool contiguous = false;
+        template<typename context_t>
+        constexpr void process(context_t& ctx) {
+            auto in = ctx.template inputs<int>();
+            contiguous = in.is_contiguous();
+            result = 0;
+            if (contiguous) {
+                const int* p = in.data();
+                for (std::size_t i = 0; i < in.size(); ++i) result += p[i] * static_cast<int>(i + 1);
+            }
+            else {
+                for (std::size_t i = 0; i < in.size(); ++i) result += in[i] * static_cast<int>(i + 1);
+            }
+        }
+    };
+
+    template<typename graph_t>
+    void run(graph_t& g) {
+        g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+    }
+
+}
+
+TEST_CASE("fan-in producers get consecutive slots") {
+
+    Value a { 1 };
+    Value b { 2 };
+    Value c { 3 };
+    Double d;
+    Sum<3> sum;
+
+    auto nA = ugraph::make_node<1>(a);
+    auto nB = ugraph::make_node<2>(b);
+    auto nC = ugraph::make_node<3>(c);
+    auto nD = ugraph::make_node<4>(d);
+    auto nSum = ugraph::make_node<5>(sum);
+
+    // Port order differs from the order in which the producers run
+    auto g = ugraph::Graph(
+        nA.output<int>() >> nD.input<int>(),
+        nC.output<int>() >> nSum.input<int, 0>(),
+        nD.output<int>() >> nSum.input<int, 1>(),
+        nB.output<int>() >> nSum.input<int, 2>()
+    );
+
+    using G = decltype(g);
+    G::graph_data_t dg;
+    g.init_graph_data(dg);
+    REQUIRE(g.all_ios_connected());
+
+    run(g);
+    CHECK(sum.contiguous);
+    CHECK(sum.result == 3 * 1 + 2 * 2 + 2 * 3);
+
+    auto s = ugraph::StaticGraph(
+        nA.output<int>() >> nD.input<int>(),
+        nC.output<int>() >> nSum.input<int, 0>(),
+        nD.output<int>() >> nSum.input<int, 1>(),
+        nB.output<int>() >> nSum.input<int, 2>()
+    );
+
+    // Statically bound inputs resolve to a plain pointer span
+    s.for_each([] (auto& m, auto& ctx) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(m)>, Sum<3>>) {
+            static_assert(std::is_same_v<decltype(ctx.template inputs<int>()), ugraph::ContiguousSpan<const int>>);
+        }
+        m.process(ctx);
+    });
+    CHECK(sum.result == 3 * 1 + 2 * 2 + 2 * 3);
+}
+
+TEST_CASE("fan-in falls back to pointer access when slots cannot be consecutive") {
+
+    Value a { 1 };
+    Value b { 10 };
+    Sum<2> first;
+    Sum<2> second;
+    Sum<2> same;
+
+    auto nA = ugraph::make_node<1>(a);
+    auto nB = ugraph::make_node<2>(b);
+    auto nFirst = ugraph::make_node<3>(first);
+    auto nSecond = ugraph::make_node<4>(second);
+    auto nSame = ugraph::make_node<5>(same);
+
+    // second wants the two slots of first in reverse order, same reads one producer twice
+    auto g = ugraph::Graph(
+        nA.output<int>() >> nFirst.input<int, 0>(),
+        nB.output<int>() >> nFirst.input<int, 1>(),
+        nB.output<int>() >> nSecond.input<int, 0>(),
+        nA.output<int>() >> nSecond.input<int, 1>(),
+        nA.output<int>() >> nSame.input<int, 0>(),
+        nA.output<int>() >> nSame.input<int, 1>()
+    );
+
+    using G = decltype(g);
+    G::graph_data_t dg;
+    g.init_graph_data(dg);
+
+    run(g);
+    CHECK(first.contiguous);
+    CHECK(first.result == 1 + 2 * 10);
+    CHECK_FALSE(second.contiguous);
+    CHECK(second.result == 10 + 2 * 1);
+    CHECK_FALSE(same.contiguous);
+    CHECK(same.result == 3);
+}
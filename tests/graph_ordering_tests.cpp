@@ -37,6 +37,12 @@ TEST_CASE("graph_view basic linear ordering") {
     CHECK(order[0] == 'A');
     CHECK(order[1] == 'B');
     CHECK(order[2] == 'C');
+
+    // id -> position lookup, also usable with run-time ids
+    static_assert(decltype(g)::position_of(102) == 1);
+    std::size_t id = 103;
+    CHECK(g.position_of(id) == 2);
+    CHECK(g.position_of(id + 1) == g.size());
 }
 
 TEST_CASE("graph_view fork-join ordering") {
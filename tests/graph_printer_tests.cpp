@@ -161,4 +161,108 @@ TEST_CASE("split topology print test") {
         CHECK(out.find("102 --> 101 --> 103 --> 104 --> 105") != std::string::npos);
     }
 
-}
\ No newline at end of file
+}
+namespace {
+
+    struct Src {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 0, 2> >;
+    };
+
+    struct Heavy {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 1, 1> >;
+    };
+
+    struct Light {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 1, 1> >;
+    };
+
+    struct Out {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 2, 0> >;
+    };
+
+    struct Pair {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 0, 1>, ugraph::IO<int, 0, 1> >;
+    };
+
+    struct PairIn {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 1, 0>, ugraph::IO<int, 1, 0> >;
+    };
+
+}
+
+TEST_CASE("profile print test") {
+
+    Src src;
+    Heavy heavy;
+    Light light;
+    Out out;
+    auto nSrc = ugraph::make_node<1>(src);
+    auto nHeavy = ugraph::make_node<2>(heavy);
+    auto nLight = ugraph::make_node<3>(light);
+    auto nOut = ugraph::make_node<4>(out);
+    auto g = ugraph::StaticGraph(
+        nSrc.output<float, 0>() >> nHeavy.input<float>(),
+        nSrc.output<float, 1>() >> nLight.input<float>(),
+        nHeavy.output<float>() >> nOut.input<float, 0>(),
+        nLight.output<float>() >> nOut.input<float, 1>()
+    );
+    using graph_t = decltype(g);
+
+    std::array<double, 4> costs {};
+    costs[g.position_of(1)] = 10;
+    costs[g.position_of(2)] = 60;
+    costs[g.position_of(3)] = 20;
+    costs[g.position_of(4)] = 10;
+
+    {
+        std::ostringstream oss;
+        g.print_profile(oss, costs);
+        const std::string s = oss.str();
+
+        CHECK(s.rfind("```mermaid\nflowchart LR\n", 0) == 0);
+        CHECK(s.find("2(\"Heavy 2<br/>60.0%\")\nstyle 2 fill:#ff0000,stroke:#d00000") != std::string::npos);
+        CHECK(s.find("3(\"Light 3<br/>20.0%\")\nstyle 3 fill:#ffaaaa\n") != std::string::npos);
+        CHECK(s.find("1(\"Src 1<br/>10.0%\")\nstyle 1 fill:#ffd5d5,stroke:#d00000") != std::string::npos);
+
+        const auto slot = std::to_string(graph_t::output_slot<float, 2, 0>());
+        CHECK(s.find("2 -->|\"float #" + slot + ", 4 B\"| 4\n") != std::string::npos);
+        CHECK(s.find("linkStyle") != std::string::npos);
+    }
+
+    {
+        std::ostringstream oss;
+        g.print_profile_dot(oss, costs, "patch");
+        const std::string s = oss.str();
+
+        CHECK(s.rfind("digraph \"patch\" {\n", 0) == 0);
+        CHECK(s.find("n2 [label=\"Heavy 2\\n60.0%\", fillcolor=\"#ff0000\", color=\"#d00000\", penwidth=3];") != std::string::npos);
+        CHECK(s.find("n3 [label=\"Light 3\\n20.0%\", fillcolor=\"#ffaaaa\"];") != std::string::npos);
+        CHECK(s.find("n1 -> n2 [label=\"float #") != std::string::npos);
+        CHECK(s.find("n2 -> n4 [label=\"float #" + std::to_string(graph_t::output_slot<float, 2, 0>()) + ", 4 B\", color=\"#d00000\", penwidth=3];") != std::string::npos);
+        CHECK(s.find("n1 -> n3 [label=\"float #" + std::to_string(graph_t::output_slot<float, 1, 1>()) + ", 4 B\"];") != std::string::npos);
+    }
+}
+
+TEST_CASE("profile print keeps edges of different types between two nodes") {
+
+    Pair a;
+    PairIn b;
+    auto nA = ugraph::make_node<1>(a);
+    auto nB = ugraph::make_node<2>(b);
+    auto g = ugraph::StaticGraph(
+        nA.output<float>() >> nB.input<float>(),
+        nA.output<int>() >> nB.input<int>()
+    );
+
+    // Both edges use slot 0 of their own type
+    static_assert(decltype(g)::output_slot<float, 1, 0>() == 0);
+    static_assert(decltype(g)::output_slot<int, 1, 0>() == 0);
+
+    std::array<double, 2> costs { 1, 1 };
+    std::ostringstream oss;
+    g.print_profile(oss, costs);
+    const std::string s = oss.str();
+
+    CHECK(s.find("1 -->|\"float #0, 4 B\"| 2\n") != std::string::npos);
+    CHECK(s.find("1 -->|\"int #0, 4 B\"| 2\n") != std::string::npos);
+}
@@ -0,0 +1,151 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <array>
+#include <tuple>
+
+// Tests for Lanes: N instances of a module as one node, batched or scalar.
+namespace {
+
+    constexpr std::size_t lane_count = 4;
+
+    // No lane batch: every lane is a Stage instance with its own Context
+    struct Stage {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        int add = 0;
+        int calls = 0;
+        void process(ugraph::Context<Manifest>& ctx) {
+            ++calls;
+            ctx.output<int>() = ctx.input<int>() + add;
+        }
+    };
+
+    // Lane batch with structure-of-arrays state
+    struct Scale {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+
+        template<std::size_t N>
+        struct batch {
+            std::array<int, N> factor {};
+            int calls = 0;
+
+            template<typename lane_context_t>
+            void process(lane_context_t& ctx) {
+                ++calls;
+                for (std::size_t l = 0; l < N; ++l) {
+                    ctx.template output<int>(l) = ctx.template input<int>(l) * factor[l];
+                }
+            }
+        };
+    };
+
+    struct Sum {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, lane_count, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            int sum = 0;
+            for (const auto& in : ctx.template inputs<int>()) {
+                sum += in;
+            }
+            ctx.template output<int>() = sum;
+        }
+    };
+
+    template<typename src_t, typename dst_t, std::size_t... L>
+    auto lane_edges(src_t& src, dst_t& dst, std::index_sequence<L...>) {
+        return std::make_tuple((src.template output<int, L>() >> dst.template input<int, L>())...);
+    }
+
+    template<template<typename...> class graph_tpl, typename stages_t, typename scales_t>
+    auto makeGraph(stages_t& stages, scales_t& scales, Sum& sum) {
+        auto nStages = ugraph::make_node<1>(stages);
+        auto nScales = ugraph::make_node<2>(scales);
+        auto nSum = ugraph::make_node<3>(sum);
+        auto edges = std::tuple_cat(
+            lane_edges(nStages, nScales, std::make_index_sequence<lane_count>{}),
+            lane_edges(nScales, nSum, std::make_index_sequence<lane_count>{})
+        );
+        return std::apply([] (const auto&... es) { return graph_tpl(es...); }, edges);
+    }
+
+    template<typename lanes_t>
+    void setup(ugraph::Lanes<Stage, lane_count>& stages, lanes_t& scales) {
+        for (std::size_t l = 0; l < lane_count; ++l) {
+            stages.lanes()[l].add = static_cast<int>(l);
+            scales.lanes().factor[l] = static_cast<int>(l + 1);
+        }
+    }
+
+}
+
+TEST_CASE("lanes multiply the ports of the module manifest") {
+
+    using stages_t = ugraph::Lanes<Stage, lane_count>;
+    using scales_t = ugraph::Lanes<Scale, lane_count>;
+
+    static_assert(!stages_t::is_batched);
+    static_assert(scales_t::is_batched);
+    static_assert(std::is_same_v<scales_t::batch_type, Scale::batch<lane_count>>);
+
+    static_assert(stages_t::Manifest::input_count<int>() == lane_count);
+    static_assert(stages_t::Manifest::output_count<int>() == lane_count);
+    static_assert(stages_t::input_port<int, 2>() == 2);
+
+    struct Two {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 2, 1>, ugraph::IO<float, 0, 3, false> >;
+    };
+    using two_t = ugraph::Lanes<Two, 3>::Manifest;
+    static_assert(two_t::input_count<int>() == 6);
+    static_assert(two_t::output_count<float>() == 9);
+    static_assert(!two_t::strict_connection<float>());
+    static_assert(ugraph::Lanes<Two, 3>::input_port<int, 2, 1>() == 5);
+    static_assert(ugraph::Lanes<Two, 3>::output_port<float, 1, 2>() == 5);
+}
+
+TEST_CASE("lanes run scalar and batched modules in a graph") {
+
+    ugraph::Lanes<Stage, lane_count> stages;
+    ugraph::Lanes<Scale, lane_count> scales;
+    Sum sum;
+    setup(stages, scales);
+
+    auto g = makeGraph<ugraph::Graph>(stages, scales, sum);
+    decltype(g)::graph_data_t dg;
+    g.init_graph_data(dg);
+
+    std::array<int, lane_count> in { 10, 20, 30, 40 };
+    int out = 0;
+    g.bind_input_at<1, 0, int>(in[0]);
+    g.bind_input_at<1, 1, int>(in[1]);
+    g.bind_input_at<1, 2, int>(in[2]);
+    g.bind_input_at<1, 3, int>(in[3]);
+    g.bind_output<3>(out);
+    REQUIRE(g.all_ios_connected());
+
+    g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+
+    // (10 + 0) * 1 + (20 + 1) * 2 + (30 + 2) * 3 + (40 + 3) * 4
+    CHECK(out == 10 + 42 + 96 + 172);
+    CHECK(scales.lanes().calls == 1);
+    for (std::size_t l = 0; l < lane_count; ++l) {
+        CHECK(stages.lanes()[l].calls == 1);
+    }
+}
+
+TEST_CASE("lanes run in a statically bound graph") {
+
+    ugraph::Lanes<Stage, lane_count> stages;
+    ugraph::Lanes<Scale, lane_count> scales;
+    Sum sum;
+    setup(stages, scales);
+
+    auto g = makeGraph<ugraph::StaticGraph>(stages, scales, sum);
+
+    g.input_at<1, 0, int>() = 1;
+    g.input_at<1, 1, int>() = 1;
+    g.input_at<1, 2, int>() = 1;
+    g.input_at<1, 3, int>() = 1;
+
+    g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+
+    CHECK(g.output<3, int>() == 1 * 1 + 2 * 2 + 3 * 3 + 4 * 4);
+}
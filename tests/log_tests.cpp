@@ -0,0 +1,144 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Tests for Logger: records pushed from nodes through ctx.log, formatted when drained.
+namespace {
+
+    struct LoggingOsc {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 0, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            ctx.template output<float>() = 1.0f;
+            ctx.log("osc {} {}", 1.5, true);
+        }
+    };
+
+    struct LoggingGain {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 1, 1> >;
+        enum class Mode : std::uint8_t { linear = 3 };
+        template<typename context_t>
+        void process(context_t& ctx) {
+            ctx.template output<float>() = ctx.template input<float>() * 0.5f;
+            ctx.log("gain {} mode {} ({})", -2, Mode::linear, "static text");
+        }
+    };
+
+    template<template<typename...> class graph_tpl>
+    auto makeGraph(LoggingOsc& osc, LoggingGain& gain) {
+        auto nOsc = ugraph::make_node<1>(osc);
+        auto nGain = ugraph::make_node<2>(gain);
+        return graph_tpl(nOsc.output<float>() >> nGain.input<float>());
+    }
+
+    const auto process = [] (auto& m, auto& ctx) { m.process(ctx); };
+
+    // Drained lines without their timestamp
+    std::vector<std::string> messages(const std::string& s) {
+        std::vector<std::string> lines;
+        std::istringstream in(s);
+        for (std::string line; std::getline(in, line);) {
+            lines.push_back(line.substr(line.find(' ') + 1));
+        }
+        return lines;
+    }
+
+}
+
+TEST_CASE("log formats the arguments of ctx.log when drained") {
+
+    LoggingOsc osc;
+    LoggingGain gain;
+    auto g = makeGraph<ugraph::Graph>(osc, gain);
+    decltype(g)::graph_data_t dg;
+    g.init_graph_data(dg);
+    float out = 0.0f;
+    g.bind_output<2>(out);
+
+    ugraph::Logger<16> logger;
+    {
+        auto attachment = logger.attach();
+        g.for_each(process);
+    }
+    // Detached: records go nowhere
+    CHECK_FALSE(ugraph::log("lost"));
+    g.for_each(process);
+
+    std::ostringstream s;
+    CHECK(logger.drain(s) == 2);
+    CHECK(messages(s.str()) == std::vector<std::string> { "osc 1.5 true", "gain -2 mode 3 (static text)" });
+    CHECK(logger.drain(s) == 0);
+    CHECK(logger.dropped() == 0);
+}
+
+TEST_CASE("logger used as a policy tags records with the node position") {
+
+    LoggingOsc osc;
+    LoggingGain gain;
+    auto g = makeGraph<ugraph::StaticGraph>(osc, gain);
+
+    ugraph::Logger<16> logger;
+    g.for_each(logger, process);
+
+    std::ostringstream s;
+    CHECK(logger.drain(s) == 2);
+    CHECK(messages(s.str()) == std::vector<std::string> { "[node 0] osc 1.5 true", "[node 1] gain -2 mode 3 (static text)" });
+    CHECK(g.output<2, float>() == 0.5f);
+}
+
+TEST_CASE("logger drops and counts the records that do not fit") {
+
+    ugraph::Logger<4> logger;
+    auto attachment = logger.attach();
+    for (int i = 0; i < 6; ++i) {
+        CHECK(ugraph::log("{}", i) == (i < 4));
+    }
+    CHECK(logger.dropped() == 2);
+
+    std::ostringstream s;
+    CHECK(logger.drain(s) == 4);
+    CHECK(messages(s.str()) == std::vector<std::string> { "0", "1", "2", "3" });
+
+    // Drained cells are reusable
+    CHECK(ugraph::log("again {}", 4u));
+    CHECK(logger.drain(s) == 1);
+}
+
+TEST_CASE("log drain writes records of several producer threads") {
+
+    constexpr std::size_t thread_count = 4;
+    constexpr std::size_t per_thread = 2000;
+
+    ugraph::Logger<256> logger;
+    std::ostringstream s;
+    std::size_t written = 0;
+    {
+        ugraph::LogDrain drain(logger, s, std::chrono::milliseconds(1));
+        std::vector<std::thread> producers;
+        for (std::size_t t = 0; t < thread_count; ++t) {
+            producers.emplace_back([&logger, t] {
+                auto attachment = logger.attach();
+                for (std::size_t i = 0; i < per_thread; ++i) {
+                    ugraph::log("thread {} record {}", t, i);
+                }
+            });
+        }
+        for (auto& p : producers) {
+            p.join();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        written = drain.written();
+    }
+
+    const auto lines = messages(s.str());
+    CHECK(lines.size() + logger.dropped() == thread_count * per_thread);
+    CHECK(lines.size() >= written);
+    for (const auto& line : lines) {
+        CHECK(line.rfind("thread ", 0) == 0);
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ugraph.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+// Two node StaticGraph (Osc 1 -> Gain 2) shared by the tests of the for_each policies that record
+// node calls: ChromeTrace, FlightRecorder and Probes.
+namespace osc_gain_test {
+
+    struct Osc {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 0, 1> >;
+        float value = 1.0f;
+        template<typename context_t>
+        void process(context_t& ctx) { ctx.template output<float>() = value; }
+    };
+
+    struct Gain {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 1, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) { ctx.template output<float>() = ctx.template input<float>() * 0.5f; }
+    };
+
+    inline auto makeGraph(Osc& osc, Gain& gain) {
+        auto nOsc = ugraph::make_node<1>(osc);
+        auto nGain = ugraph::make_node<2>(gain);
+        return ugraph::StaticGraph(nOsc.output<float>() >> nGain.input<float>());
+    }
+
+    using graph_t = decltype(makeGraph(std::declval<Osc&>(), std::declval<Gain&>()));
+
+    inline const auto process = [] (auto& m, auto& ctx) { m.process(ctx); };
+
+    inline std::size_t occurrences(const std::string& s, const std::string& what) {
+        std::size_t n = 0;
+        for (auto pos = s.find(what); pos != s.npos; pos = s.find(what, pos + 1)) {
+            ++n;
+        }
+        return n;
+    }
+
+} // namespace osc_gain_test
@@ -0,0 +1,117 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <cstdint>
+#include <vector>
+
+// Tests for OwningGraph: modules copied into the graph, contiguous in topological order.
+namespace {
+
+    struct Stage {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        int add = 0;
+        int calls = 0;
+        void process(ugraph::Context<Manifest>& ctx) {
+            ++calls;
+            ctx.output<int>() = ctx.input<int>() + add;
+        }
+    };
+
+    struct Wide {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        std::array<int, 40> state {};
+        void process(ugraph::Context<Manifest>& ctx) {
+            state[0] += ctx.input<int>();
+            ctx.output<int>() = state[0];
+        }
+    };
+
+}
+
+TEST_CASE("owning graph stores copies of its modules in topological order") {
+
+    Stage a { 1 };
+    Wide w;
+    Stage b { 100 };
+
+    auto nA = ugraph::make_node<1>(a);
+    auto nW = ugraph::make_node<2>(w);
+    auto nB = ugraph::make_node<3>(b);
+
+    // Edges listed out of order on purpose
+    auto g = ugraph::OwningGraph(
+        nW.output<int>() >> nB.input<int>(),
+        nA.output<int>() >> nW.input<int>()
+    );
+
+    using G = decltype(g);
+    G::graph_data_t dg;
+    g.init_graph_data(dg);
+
+    int in = 5;
+    int out = 0;
+    g.bind_input<1>(in);
+    g.bind_output<3>(out);
+
+    std::vector<std::uintptr_t> addresses;
+    g.for_each([&] (auto& m, auto& ctx) {
+        m.process(ctx);
+        addresses.push_back(reinterpret_cast<std::uintptr_t>(&m));
+    });
+
+    CHECK(out == 106);
+
+    // The prototypes are left untouched, the graph works on its own instances
+    CHECK(a.calls == 0);
+    CHECK(b.calls == 0);
+    CHECK(g.module_ptr_by_id<1>() != &a);
+    CHECK(g.module_ptr_by_id<1>()->calls == 1);
+    CHECK(g.module_ptr_by_id<3>()->add == 100);
+
+    REQUIRE(addresses.size() == 3);
+    for (std::size_t i = 0; i < addresses.size(); ++i) {
+        CHECK(addresses[i] % ugraph::cache_line_size == 0);
+        CHECK(addresses[i] >= reinterpret_cast<std::uintptr_t>(&g));
+        CHECK(addresses[i] < reinterpret_cast<std::uintptr_t>(&g) + sizeof(G));
+        if (i > 0) {
+            CHECK(addresses[i] > addresses[i - 1]);
+        }
+    }
+    CHECK(addresses[1] - addresses[0] == ugraph::cache_line_size);
+    CHECK(addresses[2] - addresses[1] == 3 * ugraph::cache_line_size);
+}
+
+TEST_CASE("owning graph flattens nested graphs into its own storage") {
+
+    Stage innerA { 10 };
+    Stage innerB { 20 };
+
+    auto nInnerA = ugraph::make_node<1>(innerA);
+    auto nInnerB = ugraph::make_node<2>(innerB);
+    auto inner = ugraph::Graph(nInnerA.output<int>() >> nInnerB.input<int>());
+
+    Stage src { 1 };
+    Stage sink { 2 };
+
+    auto nSrc = ugraph::make_node<100>(src);
+    auto nInner = ugraph::make_node<200>(inner);
+    auto nSink = ugraph::make_node<300>(sink);
+
+    auto g = ugraph::OwningGraph(
+        nSrc.output<int>() >> nInner.input<int>(),
+        nInner.output<int>() >> nSink.input<int>()
+    );
+
+    decltype(g)::graph_data_t dg;
+    g.init_graph_data(dg);
+
+    int in = 0;
+    int out = 0;
+    g.bind_input<100>(in);
+    g.bind_output<300>(out);
+
+    g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+
+    CHECK(out == 33);
+    CHECK(innerA.calls == 0);
+    CHECK(g.module_ptr_by_id<201>()->calls == 1);
+}
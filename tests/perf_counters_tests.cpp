@@ -0,0 +1,120 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+
+// Tests for PerfProfiler: hardware counters per node, or plain call counts where perf events are
+// not permitted (the usual case in containers).
+namespace {
+
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) { ctx.template output<int>() = 1; }
+    };
+
+    struct Spin {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            volatile int acc = ctx.template input<int>();
+            for (int i = 0; i < 10000; ++i) {
+                acc = acc + i;
+            }
+            ctx.template output<int>() = acc;
+        }
+    };
+
+}
+
+TEST_CASE("perf profiler counts every node call") {
+
+    Source src;
+    Spin spin;
+    auto nSrc = ugraph::make_node<1>(src);
+    auto nSpin = ugraph::make_node<2>(spin);
+    auto g = ugraph::StaticGraph(nSrc.output<int>() >> nSpin.input<int>());
+
+    ugraph::PerfProfiler<decltype(g)::size()> profiler;
+    auto w = profiler.worker(0);
+    for (int i = 0; i < 4; ++i) {
+        g.for_each(w, [] (auto& m, auto& ctx) { m.process(ctx); });
+    }
+
+    const auto src_stats = profiler.stats(g.position_of(1));
+    const auto spin_stats = profiler.stats(g.position_of(2));
+    CHECK(src_stats.calls == 4);
+    CHECK(spin_stats.calls == 4);
+
+    if (!w.available()) {
+        MESSAGE("perf events are not permitted here, only call counts were checked");
+        CHECK(spin_stats[ugraph::PerfEvent::cycles] == 0);
+        CHECK(spin_stats.ipc() == 0.0);
+        return;
+    }
+    if (w.counters().available(ugraph::PerfEvent::instructions)) {
+        CHECK(spin_stats.per_call(ugraph::PerfEvent::instructions) > 10000.0);
+        CHECK(spin_stats[ugraph::PerfEvent::instructions] > src_stats[ugraph::PerfEvent::instructions]);
+    }
+}
+
+TEST_CASE("perf profiler sums the workers") {
+
+    ugraph::PerfProfiler<2, 2> profiler;
+    std::array<std::uint64_t, ugraph::perf_event_count> delta {};
+    delta[static_cast<std::size_t>(ugraph::PerfEvent::cycles)] = 100;
+    delta[static_cast<std::size_t>(ugraph::PerfEvent::instructions)] = 250;
+    profiler.record(0, 1, delta);
+    profiler.record(1, 1, delta);
+
+    const auto s = profiler.stats(1);
+    CHECK(s.calls == 2);
+    CHECK(s[ugraph::PerfEvent::cycles] == 200);
+    CHECK(s.per_call(ugraph::PerfEvent::instructions) == doctest::Approx(250.0));
+    CHECK(s.ipc() == doctest::Approx(2.5));
+    CHECK(profiler.stats(0).calls == 0);
+}
+
+TEST_CASE("perf counter deltas are scaled when the group was multiplexed") {
+
+    constexpr auto cycles = static_cast<std::size_t>(ugraph::PerfEvent::cycles);
+    ugraph::PerfReading before;
+    before.values[cycles] = 1000;
+    before.time_enabled = 500;
+    before.time_running = 500;
+
+    ugraph::PerfReading after = before;
+    after.values[cycles] = 1300;
+    after.time_enabled = 1500;
+    after.time_running = 1000;
+
+    auto d = ugraph::PerfCounters::delta(before, after);
+    CHECK(d.running);
+    CHECK(d.scaled);
+    CHECK(d.values[cycles] == 600);
+
+    after.time_running = 1500;
+    d = ugraph::PerfCounters::delta(before, after);
+    CHECK(!d.scaled);
+    CHECK(d.values[cycles] == 300);
+
+    after.time_running = before.time_running;
+    d = ugraph::PerfCounters::delta(before, after);
+    CHECK(!d.running);
+    CHECK(d.values[cycles] == 0);
+}
+
+TEST_CASE("perf profiler leaves out calls the group did not count") {
+
+    ugraph::PerfProfiler<1> profiler;
+    std::array<std::uint64_t, ugraph::perf_event_count> delta {};
+    delta[static_cast<std::size_t>(ugraph::PerfEvent::cycles)] = 100;
+    profiler.record(0, 0, delta);
+    profiler.record(0, 0, delta, true, true);
+    profiler.record(0, 0, delta, false);
+
+    const auto s = profiler.stats(0);
+    CHECK(s.calls == 3);
+    CHECK(s.scaled == 1);
+    CHECK(s.unscheduled == 1);
+    CHECK(s[ugraph::PerfEvent::cycles] == 200);
+    CHECK(s.per_call(ugraph::PerfEvent::cycles) == doctest::Approx(100.0));
+}
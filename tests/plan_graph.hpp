@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ugraph.hpp"
+
+// Graph definition compiled once by ugraph_plan_gen (see tests/CMakeLists.txt) and by the tests
+// comparing the generated plan against the StaticGraph it was generated from.
+namespace plan_test {
+
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 1, 2, false> >;
+        float gain = 1.0f;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            ctx.template output<float>(0) = ctx.template input<float>() * gain;
+            ctx.template output<float>(1) = -ctx.template input<float>();
+        }
+    };
+
+    struct Scale {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 1, 1> >;
+        float factor = 2.0f;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            ctx.template output<float>() = ctx.template input<float>() * factor;
+        }
+    };
+
+    struct Mix {
+        using Manifest = ugraph::Manifest< ugraph::IO<float, 2, 1, false>, ugraph::IO<int, 0, 1, false> >;
+        int calls = 0;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            float sum = 0.0f;
+            for (const auto& in : ctx.template inputs<float>()) {
+                sum += in;
+            }
+            ctx.template output<float>() = sum;
+            ctx.template output<int>() = ++calls;
+        }
+    };
+
+    struct Modules {
+        Source src;
+        Scale scale;
+        Mix mix;
+    };
+
+    inline auto make_graph(Modules& m) {
+        auto nSrc = ugraph::make_node<1>(m.src);
+        auto nScale = ugraph::make_node<2>(m.scale);
+        auto nMix = ugraph::make_node<3>(m.mix);
+        return ugraph::StaticGraph(
+            nSrc.output<float, 0>() >> nScale.input<float>(),
+            nScale.output<float>() >> nMix.input<float, 0>(),
+            nSrc.output<float, 1>() >> nMix.input<float, 1>()
+        );
+    }
+
+    using graph_t = decltype(make_graph(std::declval<Modules&>()));
+
+}
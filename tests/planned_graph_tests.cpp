@@ -0,0 +1,67 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include "plan_graph.hpp"
+#include "plan_test_plan.hpp"
+
+#include <sstream>
+
+// Tests for PlannedGraph: plans generated offline by ugraph_plan_gen must run like the graph they
+// were generated from.
+namespace {
+
+    using planned_t = ugraph::PlannedGraph<plan_test_plan>;
+
+    struct Local {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, 1> >;
+        template<typename context_t>
+        void process(context_t&) {}
+    };
+
+    struct Sink {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 0> >;
+        template<typename context_t>
+        void process(context_t&) {}
+    };
+
+}
+
+TEST_CASE("generated plan matches the graph it was generated from") {
+
+    using graph_t = plan_test::graph_t;
+
+    static_assert(planned_t::size() == graph_t::size());
+    CHECK(planned_t::ids() == graph_t::ids());
+    static_assert(planned_t::slot_count<float>() == graph_t::slot_count<float>());
+    static_assert(planned_t::slot_count<int>() == graph_t::slot_count<int>());
+    static_assert(planned_t::position_of(3) == 2);
+
+    plan_test::Modules gm;
+    plan_test::Modules pm;
+    auto g = plan_test::make_graph(gm);
+    planned_t p(pm.src, pm.scale, pm.mix);
+
+    for (float v : { 1.0f, -3.5f, 8.0f }) {
+        g.input<1, float>() = v;
+        p.input<1, float>() = v;
+        g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+        p.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+
+        CHECK(p.output<3, float>() == g.output<3, float>());
+        CHECK(p.output<3, float>() == doctest::Approx(v * 2.0f - v));
+        CHECK(p.output<3, int>() == g.output<3, int>());
+    }
+    CHECK(pm.mix.calls == 3);
+}
+
+TEST_CASE("write_plan refuses types that cannot be named from a header") {
+
+    Local local;
+    Sink sink;
+    auto nLocal = ugraph::make_node<1>(local);
+    auto nSink = ugraph::make_node<2>(sink);
+    auto g = ugraph::StaticGraph(nLocal.output<int>() >> nSink.input<int>());
+
+    std::ostringstream out;
+    CHECK_FALSE(ugraph::write_plan<decltype(g)>(out, "local_plan"));
+    CHECK(out.str().rfind("#error", 0) == 0);
+}
@@ -0,0 +1,96 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include "osc_gain_graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <elf.h>
+#endif
+
+// Tests for Probes: USDT notes emitted in the binary, nodes still called through the policy.
+namespace {
+
+    using namespace osc_gain_test;
+
+#if defined(__linux__) && defined(__LP64__)
+    // "provider:name args" of every stapsdt note of the running executable, as readelf -n lists them
+    std::set<std::string> stapsdt_notes() {
+        std::ifstream file("/proc/self/exe", std::ios::binary);
+        const std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::set<std::string> notes;
+        if (image.size() < sizeof(Elf64_Ehdr)) {
+            return notes;
+        }
+        Elf64_Ehdr eh;
+        std::memcpy(&eh, image.data(), sizeof(eh));
+        std::vector<Elf64_Shdr> sections(eh.e_shnum);
+        std::memcpy(sections.data(), image.data() + eh.e_shoff, eh.e_shnum * sizeof(Elf64_Shdr));
+        const char* section_names = image.data() + sections[eh.e_shstrndx].sh_offset;
+
+        for (const auto& sh : sections) {
+            if (sh.sh_type != SHT_NOTE || std::strcmp(section_names + sh.sh_name, ".note.stapsdt") != 0) {
+                continue;
+            }
+            const auto align4 = [] (std::size_t n) { return (n + 3) & ~std::size_t(3); };
+            for (std::size_t pos = 0; pos + sizeof(Elf64_Nhdr) <= sh.sh_size;) {
+                Elf64_Nhdr nh;
+                std::memcpy(&nh, image.data() + sh.sh_offset + pos, sizeof(nh));
+                const char* desc = image.data() + sh.sh_offset + pos + sizeof(nh) + align4(nh.n_namesz);
+                if (nh.n_type == 3) {
+                    // pc, base, semaphore, then provider, name and arguments
+                    const char* provider = desc + 3 * sizeof(std::uint64_t);
+                    const char* name = provider + std::strlen(provider) + 1;
+                    const char* args = name + std::strlen(name) + 1;
+                    notes.insert(std::string(provider) + ":" + name + " " + args);
+                }
+                pos += sizeof(nh) + align4(nh.n_namesz) + align4(nh.n_descsz);
+            }
+        }
+        return notes;
+    }
+#endif
+
+}
+
+TEST_CASE("probes policy calls every node once per frame") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    ugraph::Probes<decltype(g)> probes;
+    std::size_t calls = 0;
+    for (int i = 0; i < 3; ++i) {
+        probes.run(g, [&] (auto& m, auto& ctx) {
+            ++calls;
+            m.process(ctx);
+        });
+    }
+    CHECK(calls == 6);
+    CHECK(probes.frame() == 3);
+    CHECK(g.output<2, float>() == 0.5f);
+}
+
+#if UGRAPH_PROBES_ENABLED && defined(__linux__) && defined(__LP64__)
+TEST_CASE("probes are listed as stapsdt notes of the binary") {
+
+    std::set<std::string> names;
+    for (const auto& note : stapsdt_notes()) {
+        if (note.rfind("ugraph:", 0) == 0) {
+            names.insert(note.substr(0, note.find(' ')));
+            // Three 64 bit arguments for node probes, one for frame probes
+            const std::size_t args = static_cast<std::size_t>(std::count(note.begin(), note.end(), '@'));
+            CHECK(args == (note.find(":node_") != note.npos ? 3u : 1u));
+        }
+    }
+    CHECK(names == std::set<std::string> { "ugraph:frame_end", "ugraph:frame_start", "ugraph:node_enter", "ugraph:node_exit" });
+}
+#endif
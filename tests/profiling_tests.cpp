@@ -0,0 +1,138 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Tests for the for_each execution policies: NoProfiling and NodeProfiler.
+namespace {
+
+    // Every read advances the clock by `step`, so each node call lasts `step` ticks
+    struct FakeClock {
+        static inline std::uint64_t time = 0;
+        static inline std::uint64_t step = 1;
+        static std::uint64_t now() {
+            const std::uint64_t t = time;
+            time += step;
+            return t;
+        }
+    };
+
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) { ctx.template output<int>() = 3; }
+    };
+
+    struct Twice {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) { ctx.template output<int>() = ctx.template input<int>() * 2; }
+    };
+
+    template<template<typename...> class graph_tpl>
+    auto makeGraph(Source& src, Twice& a, Twice& b) {
+        auto nSrc = ugraph::make_node<1>(src);
+        auto nA = ugraph::make_node<2>(a);
+        auto nB = ugraph::make_node<3>(b);
+        return graph_tpl(nSrc.output<int>() >> nA.input<int>(), nA.output<int>() >> nB.input<int>());
+    }
+
+    const auto process = [] (auto& m, auto& ctx) { m.process(ctx); };
+
+}
+
+TEST_CASE("no profiling policy runs the graph unchanged") {
+
+    Source src;
+    Twice a, b;
+    auto g = makeGraph<ugraph::StaticGraph>(src, a, b);
+
+    ugraph::NoProfiling policy;
+    g.for_each(policy, process);
+    CHECK(g.output<3, int>() == 12);
+}
+
+TEST_CASE("node profiler records every node call") {
+
+    Source src;
+    Twice a, b;
+    auto g = makeGraph<ugraph::Graph>(src, a, b);
+    decltype(g)::graph_data_t dg;
+    g.init_graph_data(dg);
+    int out = 0;
+    g.bind_output<3>(out);
+
+    ugraph::NodeProfiler<decltype(g)::size(), FakeClock, 8> profiler;
+    FakeClock::step = 5;
+    g.for_each(profiler, process);
+    FakeClock::step = 1;
+    g.for_each(profiler, process);
+    CHECK(out == 12);
+
+    for (std::size_t i = 0; i < profiler.size(); ++i) {
+        const auto t = profiler.timings(i);
+        CHECK(t.count == 2);
+        CHECK(t.min == 1);
+        CHECK(t.max == 5);
+        CHECK(t.mean() == doctest::Approx(3.0));
+        CHECK(t.histogram[1] == 1);  // 1 tick
+        CHECK(t.histogram[3] == 1);  // 5 ticks: [4, 8)
+    }
+
+    // Durations past the last bucket are clamped into it
+    profiler.record(0, 1u << 20);
+    CHECK(profiler.timings(0).histogram[7] == 1);
+
+    profiler.reset();
+    const auto t = profiler.timings(0);
+    CHECK(t.count == 0);
+    CHECK(t.min == 0);
+    CHECK(t.max == 0);
+}
+
+TEST_CASE("node profiler indexes timings by topological position") {
+
+    Source src;
+    Twice a, b;
+    auto g = makeGraph<ugraph::StaticGraph>(src, a, b);
+
+    ugraph::NodeProfiler<decltype(g)::size(), FakeClock> profiler;
+    FakeClock::step = 1;
+    g.for_each(profiler, process);
+    profiler.record(g.position_of(2), 100);
+
+    CHECK(profiler.timings(g.position_of(1)).count == 1);
+    CHECK(profiler.timings(g.position_of(2)).count == 2);
+    CHECK(profiler.timings(g.position_of(2)).max == 100);
+    CHECK(profiler.timings(g.position_of(3)).count == 1);
+}
+
+TEST_CASE("node profiler timings are read consistently from another thread") {
+
+    ugraph::NodeProfiler<1, FakeClock, 4> profiler;
+    std::atomic<bool> done { false };
+    std::atomic<int> torn { 0 };
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            const auto t = profiler.timings(0);
+            std::uint64_t hits = 0;
+            for (auto h : t.histogram) {
+                hits += h;
+            }
+            if (hits != t.count || t.total != 2 * t.count) {
+                ++torn;
+            }
+        }
+    });
+
+    for (int i = 0; i < 100000; ++i) {
+        profiler.record(0, 2);
+    }
+    done = true;
+    reader.join();
+
+    CHECK(torn == 0);
+    CHECK(profiler.timings(0).count == 100000);
+}
@@ -0,0 +1,146 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <array>
+#include <tuple>
+
+// Tests for Replicate: one graph type instantiated N times, standalone and as a node.
+namespace {
+
+    constexpr std::size_t replica_count = 8;
+
+    struct Scale {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        int factor = 1;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            ctx.template output<int>() = ctx.template input<int>() * factor;
+        }
+    };
+
+    struct Offset {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1> >;
+        int calls = 0;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            ++calls;
+            ctx.template output<int>() = ctx.template input<int>() + 1;
+        }
+    };
+
+    struct Fan {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 0, replica_count> >;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            for (std::size_t r = 0; r < replica_count; ++r) {
+                ctx.template output<int>(r) = 10;
+            }
+        }
+    };
+
+    struct Sum {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, replica_count, 1> >;
+        template<typename context_t>
+        void process(context_t& ctx) {
+            int sum = 0;
+            for (const auto& in : ctx.template inputs<int>()) {
+                sum += in;
+            }
+            ctx.template output<int>() = sum;
+        }
+    };
+
+    struct Voice {
+        Scale scale;
+        Offset offset;
+    };
+
+    auto makeVoice(Voice& v) {
+        auto nScale = ugraph::make_node<1>(v.scale);
+        auto nOffset = ugraph::make_node<2>(v.offset);
+        return ugraph::Graph(nScale.output<int>() >> nOffset.input<int>());
+    }
+
+    using voice_graph_t = decltype(makeVoice(std::declval<Voice&>()));
+    using voices_t = ugraph::Replicate<voice_graph_t, replica_count>;
+
+    template<typename fan_t, typename voices_node_t, typename sum_t, std::size_t... R>
+    auto makeEdges(fan_t& fan, voices_node_t& voices, sum_t& sum, std::index_sequence<R...>) {
+        return std::make_tuple(
+            (fan.template output<int, R>() >> voices.template input<int, voices_t::input_port<int, R>()>())...,
+            (voices.template output<int, voices_t::output_port<int, R>()>() >> sum.template input<int, R>())...
+        );
+    }
+
+}
+
+TEST_CASE("graph reports its unconnected ports") {
+
+    constexpr auto inputs = voice_graph_t::unconnected_inputs<int>();
+    constexpr auto outputs = voice_graph_t::unconnected_outputs<int>();
+
+    static_assert(inputs.size() == 1);
+    static_assert(inputs[0].node_id == 1 && inputs[0].port == 0);
+    static_assert(outputs.size() == 1);
+    static_assert(outputs[0].node_id == 2 && outputs[0].port == 0);
+
+    static_assert(voices_t::Manifest::input_count<int>() == replica_count);
+    static_assert(voices_t::Manifest::output_count<int>() == replica_count);
+    static_assert(voices_t::input_port<int, 3>() == 3);
+}
+
+TEST_CASE("replicate builds every replica with its index") {
+
+    std::array<Voice, replica_count> v;
+    voices_t voices([&] (std::size_t r) {
+        v[r].scale.factor = static_cast<int>(r + 1);
+        return makeVoice(v[r]);
+    });
+
+    std::array<int, replica_count> in {};
+    std::array<int, replica_count> out {};
+    for (std::size_t r = 0; r < replica_count; ++r) {
+        in[r] = 2;
+        voices[r].bind_input<1>(in[r]);
+        voices[r].bind_output<2>(out[r]);
+    }
+
+    voices.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+
+    for (std::size_t r = 0; r < replica_count; ++r) {
+        CHECK(out[r] == 2 * static_cast<int>(r + 1) + 1);
+        CHECK(v[r].offset.calls == 1);
+    }
+}
+
+TEST_CASE("replicate runs as a node of an outer graph") {
+
+    std::array<Voice, replica_count> v;
+    voices_t voices([&] (std::size_t r) {
+        v[r].scale.factor = static_cast<int>(r);
+        return makeVoice(v[r]);
+    });
+
+    Fan fan;
+    Sum sum;
+
+    auto nFan = ugraph::make_node<100>(fan);
+    auto nVoices = ugraph::make_node<200>(voices);
+    auto nSum = ugraph::make_node<300>(sum);
+
+    auto edges = makeEdges(nFan, nVoices, nSum, std::make_index_sequence<replica_count>{});
+    auto g = std::apply([] (const auto&... es) { return ugraph::Graph(es...); }, edges);
+
+    decltype(g)::graph_data_t dg;
+    g.init_graph_data(dg);
+    int out = 0;
+    g.bind_output<300>(out);
+    REQUIRE(g.all_ios_connected());
+
+    g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+
+    // sum of (10 * r + 1) for r in [0, 8)
+    CHECK(out == 10 * 28 + 8);
+    for (std::size_t r = 0; r < replica_count; ++r) {
+        CHECK(v[r].offset.calls == 1);
+    }
+}
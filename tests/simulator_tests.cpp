@@ -0,0 +1,138 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <array>
+
+// Tests for ScheduleSimulator: predicted frame times of the scheduling policies.
+namespace {
+
+    struct Stage {};
+
+    // 1 -> {2, 3, 4, 5} -> 6
+    using src = ugraph::NodeTag<1, Stage>;
+    using b0 = ugraph::NodeTag<2, Stage>;
+    using b1 = ugraph::NodeTag<3, Stage>;
+    using b2 = ugraph::NodeTag<4, Stage>;
+    using b3 = ugraph::NodeTag<5, Stage>;
+    using sink = ugraph::NodeTag<6, Stage>;
+
+    using fan_t = ugraph::Topology<
+        std::pair<src, b0>, std::pair<src, b1>, std::pair<src, b2>, std::pair<src, b3>,
+        std::pair<b0, sink>, std::pair<b1, sink>, std::pair<b2, sink>, std::pair<b3, sink>
+    >;
+
+    // Branches of 100 ticks between a source and a sink of 10
+    ugraph::ConstantCosts<6> fan_costs() {
+        ugraph::ConstantCosts<6> c;
+        for (std::size_t i = 0; i < 6; ++i) {
+            c.costs[i] = 100;
+        }
+        c.costs[fan_t::position_of(1)] = 10;
+        c.costs[fan_t::position_of(6)] = 10;
+        return c;
+    }
+
+    double simulate(ugraph::SchedulePolicy policy, std::size_t workers, double queue_cost = 0) {
+        ugraph::ScheduleSimulator<fan_t> sim;
+        ugraph::SimulationOptions o;
+        o.policy = policy;
+        o.workers = workers;
+        o.frames = 10;
+        o.queue_cost = queue_cost;
+        sim.run(o, fan_costs());
+        CHECK(sim.frames() == 10);
+        return sim.mean();
+    }
+
+}
+
+TEST_CASE("constant costs give exact frame times") {
+
+    using ugraph::SchedulePolicy;
+
+    CHECK(simulate(SchedulePolicy::serial, 4) == doctest::Approx(420));
+    CHECK(simulate(SchedulePolicy::levels, 1) == doctest::Approx(420));
+    CHECK(simulate(SchedulePolicy::levels, 2) == doctest::Approx(220));
+    CHECK(simulate(SchedulePolicy::levels, 4) == doctest::Approx(120));
+    CHECK(simulate(SchedulePolicy::levels, 3) == doctest::Approx(220));
+    CHECK(simulate(SchedulePolicy::static_lanes, 4) == doctest::Approx(120));
+    CHECK(simulate(SchedulePolicy::work_stealing, 1) == doctest::Approx(420));
+    CHECK(simulate(SchedulePolicy::work_stealing, 4) == doctest::Approx(120));
+
+    // The span bounds every policy
+    constexpr auto report = ugraph::analyze_parallelism<fan_t>(std::array<double, 6> { 10, 100, 100, 100, 100, 10 });
+    CHECK(simulate(SchedulePolicy::work_stealing, 8) == doctest::Approx(report.span));
+}
+
+TEST_CASE("static lanes place the longest nodes first") {
+
+    // One branch six times longer than everything else: LPT gives it a lane of its own
+    ugraph::ConstantCosts<6> costs;
+    for (std::size_t i = 0; i < 6; ++i) {
+        costs.costs[i] = 1;
+    }
+    const std::size_t longest = fan_t::position_of(5);
+    costs.costs[longest] = 6;
+
+    ugraph::ScheduleSimulator<fan_t> sim;
+    ugraph::SimulationOptions o;
+    o.policy = ugraph::SchedulePolicy::static_lanes;
+    o.workers = 2;
+    o.frames = 1;
+    sim.run(o, costs);
+
+    for (std::size_t i = 0; i < 6; ++i) {
+        if (i != longest) {
+            CHECK(sim.lane_of(i) != sim.lane_of(longest));
+        }
+    }
+}
+
+TEST_CASE("simulator reports idle time, steals and contention") {
+
+    ugraph::ScheduleSimulator<fan_t> sim;
+    ugraph::SimulationOptions o;
+    o.policy = ugraph::SchedulePolicy::work_stealing;
+    o.workers = 4;
+    o.frames = 1;
+    o.queue_cost = 1;
+    sim.run(o, fan_costs());
+
+    // The four branches are queued on worker 0: three of them are stolen, one at a time
+    CHECK(sim.steals() == doctest::Approx(3));
+    CHECK(sim.contention() > 0);
+    CHECK(sim.mean() > 120);
+    CHECK(sim.idle_fraction() > 0);
+    CHECK(sim.idle_fraction() < 1);
+
+    sim.reset();
+    o.policy = ugraph::SchedulePolicy::serial;
+    sim.run(o, fan_costs());
+    CHECK(sim.idle_fraction() == doctest::Approx(0));
+    CHECK(sim.quantile(0.5) == doctest::Approx(420));
+}
+
+TEST_CASE("random and measured costs spread the frame times") {
+
+    ugraph::NormalCosts<6> normal;
+    for (std::size_t i = 0; i < 6; ++i) {
+        normal.means[i] = 1000;
+        normal.stddevs[i] = 100;
+    }
+
+    ugraph::ScheduleSimulator<fan_t> sim;
+    ugraph::SimulationOptions o;
+    o.policy = ugraph::SchedulePolicy::serial;
+    o.frames = 2000;
+    sim.run(o, normal);
+    CHECK(sim.mean() == doctest::Approx(6000).epsilon(0.02));
+    CHECK(sim.quantile(0.01) < sim.quantile(0.99));
+
+    // Every node measured at exactly 100 ticks: the distribution keeps that mean
+    ugraph::NodeProfiler<6> profiler;
+    for (std::size_t i = 0; i < 6; ++i) {
+        profiler.record(i, 100);
+    }
+    sim.reset();
+    sim.run(o, ugraph::MeasuredCosts<6, 32>(profiler));
+    CHECK(sim.mean() == doctest::Approx(600));
+}
@@ -0,0 +1,123 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include <vector>
+
+// Tests for StaticGraph: compile-time port -> slot binding, graph-owned slots, no init step.
+namespace {
+
+    struct Source {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 1, false> >;
+        int offset = 0;
+        template<typename context_t>
+        constexpr void process(context_t& ctx) {
+            ctx.template output<int>() = ctx.template input<int>() + offset;
+        }
+    };
+
+    struct Add {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 2, 1, false> >;
+        template<typename context_t>
+        constexpr void process(context_t& ctx) {
+            int sum = 0;
+            for (const auto& in : ctx.template inputs<int>()) {
+                sum += in;
+            }
+            ctx.template output<int>() = sum;
+        }
+    };
+
+    struct Split {
+        using Manifest = ugraph::Manifest< ugraph::IO<int, 1, 2> >;
+        template<typename context_t>
+        constexpr void process(context_t& ctx) {
+            ctx.template output<int>(0) = ctx.template input<int>();
+            ctx.template output<int>(1) = -ctx.template input<int>();
+        }
+    };
+
+    template<typename graph_t>
+    constexpr void run(graph_t& g) {
+        g.for_each([] (auto& m, auto& ctx) { m.process(ctx); });
+    }
+
+    constexpr auto makeGraph(Source& src, Split& split, Add& add) {
+        auto nSrc = ugraph::make_node<1>(src);
+        auto nSplit = ugraph::make_node<2>(split);
+        auto nAdd = ugraph::make_node<3>(add);
+        return ugraph::StaticGraph(
+            nSrc.output<int>() >> nSplit.input<int>(),
+            nSplit.output<int, 0>() >> nAdd.input<int, 0>()
+        );
+    }
+
+    constexpr int runConstexpr(int v) {
+        Source src { 1 };
+        Split split;
+        Add add;
+        auto g = makeGraph(src, split, add);
+        g.input<1, int>() = v;
+        g.input_at<3, 1, int>() = 100;
+        run(g);
+        return g.output<3, int>();
+    }
+
+}
+
+TEST_CASE("static graph binds ports to graph-owned slots") {
+
+    Source src { 1 };
+    Split split;
+    Add add;
+
+    auto g = makeGraph(src, split, add);
+    using G = decltype(g);
+
+    // Connected ports share colored slots, each unconnected port owns one more slot:
+    // source input, split output 1, add input 1, add output.
+    static_assert(G::data_count<int>() == 2);
+    static_assert(G::slot_count<int>() == G::data_count<int>() + 4);
+    static_assert(std::tuple_size_v<std::tuple_element_t<0, G::graph_data_t>> == G::slot_count<int>());
+
+    g.input<1, int>() = 4;
+    g.input_at<3, 1, int>() = 10;
+
+    run(g);
+
+    CHECK(g.output_at<2, 1, int>() == -5);
+    CHECK(g.output<3, int>() == 15);
+
+    g.input<1, int>() = 9;
+    run(g);
+    CHECK(g.output<3, int>() == 20);
+}
+
+TEST_CASE("static graph contexts hold no per-node state") {
+
+    Source src;
+    Split split;
+    Add add;
+
+    auto g = makeGraph(src, split, add);
+
+    std::size_t context_size = 0;
+    g.for_each([&] (auto&, auto& ctx) {
+        context_size = sizeof(ctx);
+        CHECK(ctx.all_ios_connected());
+    });
+    CHECK(context_size == sizeof(void*));
+
+    // Besides its slots, the graph is smaller than a pointer-bound graph of the same shape
+    auto nSrc = ugraph::make_node<1>(src);
+    auto nSplit = ugraph::make_node<2>(split);
+    auto nAdd = ugraph::make_node<3>(add);
+    auto dynamic = ugraph::Graph(
+        nSrc.output<int>() >> nSplit.input<int>(),
+        nSplit.output<int, 0>() >> nAdd.input<int, 0>()
+    );
+    using G = decltype(g);
+    CHECK(sizeof(G) - sizeof(G::graph_data_t) < sizeof(dynamic));
+}
+
+TEST_CASE("static graph runs in constant evaluation") {
+    static_assert(runConstexpr(5) == 106);
+}
@@ -69,6 +69,17 @@ namespace {
         });
     static_assert(variadic_ids[0] == ids[0] && variadic_ids[1] == ids[1]);
 
+    // CSR adjacency and id -> position lookups.
+    constexpr const auto& adj = CTGraph::adjacency();
+    static_assert(adj.edge_count() == 5);
+    static_assert(adj.out_degree(adj.index_of(1)) == 3 && adj.out_degree(adj.index_of(2)) == 2);
+    static_assert(adj.in_degree[adj.index_of(3)] == 2 && adj.in_degree[adj.index_of(1)] == 0);
+    static_assert(adj.targets[adj.offsets[adj.index_of(2)]] == adj.index_of(4));
+    static_assert(adj.index_of(5) == ugraph::detail::npos);
+    static_assert(CTGraph::position_of(1) == 0 && CTGraph::position_of(2) == 1);
+    static_assert(CTGraph::position_of(5) == CTGraph::size());
+    static_assert(std::is_same_v<CTGraph::find_type_by_id<3>::type, V3>);
+
 }
 
 //------------------------------------------------------------------------------
@@ -51,6 +51,11 @@ namespace {
     static_assert(count_pair(Outer::edges(), ICo, X::id()) == 1, "IC->X must exist");
     static_assert(count_pair(Outer::edges(), X::id(), IAo) == 1, "X->IA must exist");
 
+    // Boundary sets cached by the inner topology
+    static_assert(Inner::entry_ids().size() == 1 && Inner::entry_ids()[0] == IA::id());
+    static_assert(Inner::exit_ids().size() == 1 && Inner::exit_ids()[0] == IC::id());
+    static_assert(Outer::entry_ids().size() == 0 && Outer::exit_ids().size() == 0, "Outer is a cycle");
+
     TEST_CASE("nested topology compile-time ordering") {
         // Ensure inner vertex ids appear in the flattened vertex list
         constexpr auto ids = Outer::ids();
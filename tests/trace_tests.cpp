@@ -0,0 +1,139 @@
+#include "doctest.h"
+#include "ugraph.hpp"
+#include "osc_gain_graph.hpp"
+#include "plan_graph.hpp"
+#include "plan_test_plan.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Tests for ChromeTrace: node events recorded per worker and written as Chrome trace JSON.
+namespace {
+
+    // Every read advances the clock by 1000 ticks, i.e. 1 us with the default ticks_per_us
+    struct FakeClock {
+        static inline std::uint64_t time = 0;
+        static std::uint64_t now() {
+            const std::uint64_t t = time;
+            time += 1000;
+            return t;
+        }
+    };
+
+    using namespace osc_gain_test;
+
+}
+
+TEST_CASE("chrome trace writes one complete event per node call") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    ugraph::ChromeTrace<graph_t, 1, 16, FakeClock> trace;
+    static_assert(decltype(trace)::size() == 2);
+
+    FakeClock::time = 0;
+    auto w = trace.worker(0);
+    g.for_each(w, process);
+    trace.next_frame();
+    g.for_each(w, process);
+    CHECK(g.output<2, float>() == 0.5f);
+
+    std::ostringstream out;
+    CHECK(trace.flush(out) == 4);
+    const std::string json = out.str();
+
+    CHECK(json.rfind("{\"traceEvents\":[", 0) == 0);
+    CHECK(occurrences(json, "\"ph\":\"X\"") == 4);
+    CHECK(occurrences(json, "\"name\":\"Osc 1\"") == 2);
+    CHECK(occurrences(json, "\"name\":\"Gain 2\"") == 2);
+    CHECK(json.find("\"ts\":0,\"dur\":1,\"args\":{\"id\":1,\"frame\":0}") != json.npos);
+    CHECK(json.find("\"ts\":6,\"dur\":1,\"args\":{\"id\":2,\"frame\":1}") != json.npos);
+
+    // Flushing drains the rings
+    std::ostringstream again;
+    CHECK(trace.flush(again) == 0);
+    CHECK(occurrences(again.str(), "\"ph\":\"X\"") == 0);
+}
+
+TEST_CASE("chrome trace keeps sub-microsecond timestamps far from the clock origin") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    ugraph::ChromeTrace<graph_t, 1, 16, FakeClock> trace;
+
+    // About 2.8 hours of steady clock nanoseconds
+    FakeClock::time = 10000000000123;
+    auto w = trace.worker(0);
+    g.for_each(w, process);
+
+    std::ostringstream out;
+    CHECK(trace.flush(out) == 2);
+    const std::string json = out.str();
+    CHECK(json.find("\"ts\":10000000000.123,\"dur\":1,\"args\":{\"id\":1") != json.npos);
+    CHECK(json.find("\"ts\":10000000002.123,\"dur\":1,\"args\":{\"id\":2") != json.npos);
+    CHECK(json.find("e+") == json.npos);
+
+    // Fractional ticks per microsecond
+    FakeClock::time = 10000000000000;
+    g.for_each(w, process);
+    std::ostringstream scaled;
+    trace.flush(scaled, 400.0);
+    CHECK(scaled.str().find("\"ts\":25000000000,\"dur\":2.5,") != scaled.str().npos);
+}
+
+TEST_CASE("chrome trace drops events when a ring is full") {
+
+    Osc osc;
+    Gain gain;
+    auto g = makeGraph(osc, gain);
+
+    ugraph::ChromeTrace<graph_t, 1, 4, FakeClock> trace;
+    auto w = trace.worker(0);
+    for (int i = 0; i < 3; ++i) {
+        g.for_each(w, process);
+    }
+    CHECK(trace.dropped() == 2);
+
+    std::ostringstream out;
+    CHECK(trace.flush(out) == 4);
+    g.for_each(w, process);
+    CHECK(trace.dropped() == 2);
+}
+
+TEST_CASE("chrome trace keeps one ring per worker") {
+
+    Osc osc[2];
+    Gain gain[2];
+    auto g0 = makeGraph(osc[0], gain[0]);
+    auto g1 = makeGraph(osc[1], gain[1]);
+
+    ugraph::ChromeTrace<graph_t, 2, 1024> trace;
+    std::thread t0([&] { auto w = trace.worker(0); for (int i = 0; i < 100; ++i) { g0.for_each(w, process); } });
+    std::thread t1([&] { auto w = trace.worker(1); for (int i = 0; i < 100; ++i) { g1.for_each(w, process); } });
+    t0.join();
+    t1.join();
+
+    std::ostringstream out;
+    CHECK(trace.flush(out) == 400);
+    CHECK(trace.dropped() == 0);
+    const std::string json = out.str();
+    CHECK(occurrences(json, "\"tid\":0,\"ts\"") == 200);
+    CHECK(occurrences(json, "\"tid\":1,\"ts\"") == 200);
+    CHECK(json.find("\"args\":{\"name\":\"worker 1\"}") != json.npos);
+}
+
+TEST_CASE("chrome trace names the nodes of a planned graph") {
+
+    ugraph::ChromeTrace<ugraph::PlannedGraph<plan_test_plan>, 1, 4, FakeClock> trace;
+    trace.record(0, 2, 0, 2000);
+
+    std::ostringstream out;
+    CHECK(trace.flush(out) == 1);
+    CHECK(out.str().find("\"name\":\"Mix 3\",\"cat\":\"node\"") != std::string::npos);
+}